@@ -0,0 +1,374 @@
+/*
+ * @file AnsTable.cpp
+ * @author Katarina McGaughy
+ * AnsTable class: The AnsTable class holds the encode and decode tables
+ * for table-based asymmetric numeral systems (tANS), the coder used by
+ * FSE. It is built from the same counts as a HuffmanAlgorithm, scaled
+ * with HuffmanAlgorithm::normalizeCounts so they add up to the table
+ * size. Unlike Huffman codes, a symbol can cost a fraction of a bit, so
+ * skewed data where one symbol takes most of the block codes close to
+ * its entropy instead of paying at least one bit per symbol.
+ *
+ * Features:
+ * -spread the symbols over 2^tableLog states the way FSE does
+ * -decode table: symbol, bits to read and next state base per state
+ * -encode a block backwards and decode it forwards through BitWriter
+ *  and BitReader
+ * -predict the coded size from the counts
+ * -serialize the normalized counts, with runs of zero counts
+ *
+ * Format of a coded block:
+ * -final encoder state (tableLog bits), then the bits for each symbol
+ *  in order, padded to a whole byte
+ *
+ * Assumptions:
+ * -symbols fit in a byte
+ * -tableLog is between MIN_ANS_TABLE_LOG and MAX_ANS_TABLE_LOG
+ * -it is never modified after construction, so it can be shared by
+ *  reference-counted pointer like a CodeTable
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "AnsTable.h"
+#include <cmath>
+#include "HuffmanAlgorithm.h"
+#include "Varint.h"
+
+// most symbols a table can hold, so a symbol fits in a byte
+static const int MAX_ANS_SYMBOLS = 256;
+
+/**
+ * highBit
+ * Preconditions: value must not be 0
+ * Postconditions: returns the index of the highest set bit
+ */
+static int highBit(uint32_t value)
+{
+	int bit = 0;
+	while (value >>= 1)
+	{
+		bit++;
+	}
+	return bit;
+}
+
+/**
+ * fromCounts
+ * this function scales counts to 2^tableLog and builds the tables
+ * Preconditions: counts must have numSymbols entries
+ * Postconditions: returns the AnsTable, or nullptr if every count is
+ * 0, more than 2^tableLog symbols occur, numSymbols is above 256 or
+ * tableLog is out of range
+ * @param counts: 64 bit frequencies for each symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param tableLog: log2 of the number of states
+ * @return: shared pointer to the new AnsTable or nullptr
+ */
+shared_ptr<const AnsTable> AnsTable::fromCounts(const uint64_t counts[],
+																int numSymbols, int tableLog)
+{
+	if (numSymbols < 1 || numSymbols > MAX_ANS_SYMBOLS ||
+		 tableLog < MIN_ANS_TABLE_LOG || tableLog > MAX_ANS_TABLE_LOG)
+	{
+		return nullptr;
+	}
+	vector<uint64_t> normalized(numSymbols, 0);
+	if (!HuffmanAlgorithm::normalizeCounts(counts, numSymbols,
+														(uint64_t)1 << tableLog,
+														normalized.data()))
+	{
+		return nullptr;
+	}
+	return fromNormalized(normalized.data(), numSymbols, tableLog);
+}
+
+/**
+ * fromNormalized
+ * this function builds the tables from counts that already add up
+ * to 2^tableLog
+ * Preconditions: normalized must have numSymbols entries
+ * Postconditions: returns the AnsTable, or nullptr if the counts do
+ * not add up to 2^tableLog, numSymbols is above 256 or tableLog is
+ * out of range
+ * @param normalized: scaled frequencies for each symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param tableLog: log2 of the number of states
+ * @return: shared pointer to the new AnsTable or nullptr
+ */
+shared_ptr<const AnsTable> AnsTable::fromNormalized(const uint64_t normalized[],
+																	 int numSymbols, int tableLog)
+{
+	if (numSymbols < 1 || numSymbols > MAX_ANS_SYMBOLS ||
+		 tableLog < MIN_ANS_TABLE_LOG || tableLog > MAX_ANS_TABLE_LOG)
+	{
+		return nullptr;
+	}
+	uint32_t tableSize = (uint32_t)1 << tableLog;
+	uint64_t sum = 0;
+	for (int s = 0; s < numSymbols; s++)
+	{
+		if (normalized[s] > tableSize)
+		{
+			return nullptr;
+		}
+		sum += normalized[s];
+	}
+	if (sum != tableSize)
+	{
+		return nullptr;
+	}
+
+	shared_ptr<AnsTable> table(new AnsTable());
+	table->tableLog_ = tableLog;
+	table->normalized_.assign(normalized, normalized + numSymbols);
+	table->symbols_.resize(numSymbols);
+	table->decodeTable_.resize(tableSize);
+	table->encodeStates_.resize(tableSize);
+
+	// spread each symbol over the states with an odd step, so its
+	// states are scattered through the table as FSE does
+	vector<uint8_t> spread(tableSize);
+	uint32_t step = (tableSize >> 1) + (tableSize >> 3) + 3;
+	uint32_t position = 0;
+	int start = 0;
+	for (int s = 0; s < numSymbols; s++)
+	{
+		uint32_t count = table->normalized_[s];
+		for (uint32_t k = 0; k < count; k++)
+		{
+			spread[position] = (uint8_t)s;
+			position = (position + step) & (tableSize - 1);
+		}
+		SymbolEntry &entry = table->symbols_[s];
+		entry.start = start;
+		if (count > 0)
+		{
+			entry.maxBits = tableLog - highBit(count);
+			entry.threshold = count << entry.maxBits;
+		}
+		start += count;
+	}
+
+	// the k-th state of a symbol stands for the value count + k, which
+	// the decoder grows back to a full state by reading bits
+	vector<uint32_t> next(table->normalized_);
+	for (uint32_t state = 0; state < tableSize; state++)
+	{
+		int s = spread[state];
+		uint32_t value = next[s]++;
+		int numBits = tableLog - highBit(value);
+		DecodeEntry &entry = table->decodeTable_[state];
+		entry.symbol = (uint8_t)s;
+		entry.numBits = (uint8_t)numBits;
+		entry.nextBase = (uint16_t)((value << numBits) - tableSize);
+		table->encodeStates_[table->symbols_[s].start + value -
+									table->normalized_[s]] =
+			 (uint16_t)(tableSize + state);
+	}
+	return table;
+}
+
+int AnsTable::size() const
+{
+	return normalized_.size();
+}
+
+int AnsTable::getTableLog() const
+{
+	return tableLog_;
+}
+
+uint32_t AnsTable::getNormalized(int symbol) const
+{
+	return normalized_[symbol];
+}
+
+/**
+ * estimateBits
+ * this function predicts the number of bits the symbols take: each
+ * symbol costs log2(2^tableLog / normalized count) bits, plus the
+ * final state
+ * Preconditions: counts must have size() entries and every symbol
+ * with a count must have states
+ * Postconditions: returns the number of bits, rounded up
+ * @param counts: 64 bit frequencies for each symbol
+ * @return: number of bits
+ */
+uint64_t AnsTable::estimateBits(const uint64_t counts[]) const
+{
+	double bits = tableLog_;
+	for (size_t s = 0; s < normalized_.size(); s++)
+	{
+		if (counts[s] > 0)
+		{
+			bits += counts[s] * (tableLog_ - log2((double)normalized_[s]));
+		}
+	}
+	return (uint64_t)ceil(bits);
+}
+
+/**
+ * encode
+ * this function encodes the bytes from last to first, so the decoder
+ * can read them first to last, and writes the final state followed
+ * by the bits of each symbol
+ * Preconditions: every byte must be a symbol with states
+ * Postconditions: the coded bits are written to out
+ * @param data: pointer to the bytes
+ * @param size: number of bytes
+ * @param out: BitWriter the bits are written to
+ */
+void AnsTable::encode(const uint8_t *data, size_t size, BitWriter &out) const
+{
+	// the bits come out last symbol first, so hold them and write them
+	// in reverse. A value and its count fit in 16 bits as tableLog is
+	// at most 12
+	vector<uint16_t> pending(size);
+	uint32_t state = (uint32_t)1 << tableLog_;
+	for (size_t i = size; i-- > 0;)
+	{
+		const SymbolEntry &entry = symbols_[data[i]];
+		int numBits = entry.maxBits - (state < entry.threshold ? 1 : 0);
+		pending[i] = (uint16_t)(((state & ((1u << numBits) - 1)) << 4) | numBits);
+		state = encodeStates_[entry.start + (state >> numBits) -
+									 normalized_[data[i]]];
+	}
+
+	out.write(state - ((uint32_t)1 << tableLog_), tableLog_);
+	for (size_t i = 0; i < size; i++)
+	{
+		out.write(pending[i] >> 4, pending[i] & 0xF);
+	}
+}
+
+/**
+ * decode
+ * this function reads count symbols from in and appends them to out
+ * as bytes
+ * Preconditions: none
+ * Postconditions: returns false if the data ends early or does not
+ * end in the state the encoder started from
+ * @param in: BitReader positioned at the final encoder state
+ * @param count: number of symbols to read
+ * @param out: vector the bytes are appended to
+ * @return: true if count symbols were read
+ */
+bool AnsTable::decode(BitReader &in, size_t count, vector<uint8_t> &out) const
+{
+	if (in.remaining() < (uint64_t)tableLog_)
+	{
+		return false;
+	}
+	uint32_t state = in.read(tableLog_);
+	for (size_t i = 0; i < count; i++)
+	{
+		const DecodeEntry &entry = decodeTable_[state];
+		if (entry.numBits > in.remaining())
+		{
+			return false;
+		}
+		out.push_back(entry.symbol);
+		state = entry.nextBase;
+		if (entry.numBits > 0)
+		{
+			state += in.read(entry.numBits);
+		}
+	}
+	// the encoder started in the first state
+	return state == 0;
+}
+
+/**
+ * serialize
+ * this function writes the table log as a byte, the number of
+ * symbols as a varint and the normalized counts as varints. After a
+ * count of 0, a varint says how many more symbols have a count of 0
+ * Preconditions: none
+ * Postconditions: the bytes are appended to out
+ * @param out: vector the bytes are appended to
+ */
+void AnsTable::serialize(vector<uint8_t> &out) const
+{
+	out.push_back((uint8_t)tableLog_);
+	writeVarint(normalized_.size(), out);
+	size_t s = 0;
+	while (s < normalized_.size())
+	{
+		writeVarint(normalized_[s], out);
+		s++;
+		if (normalized_[s - 1] == 0)
+		{
+			size_t run = 0;
+			while (s < normalized_.size() && normalized_[s] == 0)
+			{
+				run++;
+				s++;
+			}
+			writeVarint(run, out);
+		}
+	}
+}
+
+/**
+ * deserialize
+ * Preconditions: none
+ * Postconditions: returns the AnsTable, or nullptr if the bytes are
+ * malformed
+ * @param data: pointer to the serialized table
+ * @param size: number of bytes available
+ * @param used: set to the number of bytes read
+ * @return: the AnsTable or nullptr
+ */
+shared_ptr<const AnsTable> AnsTable::deserialize(const uint8_t *data,
+																 size_t size, size_t &used)
+{
+	if (size == 0)
+	{
+		return nullptr;
+	}
+	int tableLog = data[0];
+	size_t pos = 1;
+	uint64_t numSymbols = 0;
+	size_t n = readVarint(data + pos, size - pos, numSymbols);
+	if (n == 0 || numSymbols < 1 || numSymbols > MAX_ANS_SYMBOLS)
+	{
+		return nullptr;
+	}
+	pos += n;
+
+	uint64_t normalized[MAX_ANS_SYMBOLS] = {};
+	uint64_t s = 0;
+	while (s < numSymbols)
+	{
+		n = readVarint(data + pos, size - pos, normalized[s]);
+		if (n == 0 || normalized[s] > ((uint64_t)1 << MAX_ANS_TABLE_LOG))
+		{
+			return nullptr;
+		}
+		pos += n;
+		s++;
+		if (normalized[s - 1] == 0)
+		{
+			uint64_t run = 0;
+			n = readVarint(data + pos, size - pos, run);
+			if (n == 0 || run > numSymbols - s)
+			{
+				return nullptr;
+			}
+			pos += n;
+			s += run;
+		}
+	}
+
+	shared_ptr<const AnsTable> table =
+		 fromNormalized(normalized, (int)numSymbols, tableLog);
+	if (table)
+	{
+		used = pos;
+	}
+	return table;
+}
@@ -0,0 +1,199 @@
+/*
+ * @file AnsTable.h
+ * @author Katarina McGaughy
+ * AnsTable class: The AnsTable class holds the encode and decode tables
+ * for table-based asymmetric numeral systems (tANS), the coder used by
+ * FSE. It is built from the same counts as a HuffmanAlgorithm, scaled
+ * with HuffmanAlgorithm::normalizeCounts so they add up to the table
+ * size. Unlike Huffman codes, a symbol can cost a fraction of a bit, so
+ * skewed data where one symbol takes most of the block codes close to
+ * its entropy instead of paying at least one bit per symbol.
+ *
+ * Features:
+ * -spread the symbols over 2^tableLog states the way FSE does
+ * -decode table: symbol, bits to read and next state base per state
+ * -encode a block backwards and decode it forwards through BitWriter
+ *  and BitReader
+ * -predict the coded size from the counts
+ * -serialize the normalized counts, with runs of zero counts
+ *
+ * Format of a coded block:
+ * -final encoder state (tableLog bits), then the bits for each symbol
+ *  in order, padded to a whole byte
+ *
+ * Assumptions:
+ * -symbols fit in a byte
+ * -tableLog is between MIN_ANS_TABLE_LOG and MAX_ANS_TABLE_LOG
+ * -it is never modified after construction, so it can be shared by
+ *  reference-counted pointer like a CodeTable
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BitStream.h"
+using namespace std;
+
+// range of table sizes, as powers of 2
+const int MIN_ANS_TABLE_LOG = 5;
+const int MAX_ANS_TABLE_LOG = 12;
+
+// table size used for blocks of bytes
+const int DEFAULT_ANS_TABLE_LOG = 11;
+
+class AnsTable
+{
+public:
+	/**
+	 * fromCounts
+	 * this function scales counts to 2^tableLog and builds the tables
+	 * Preconditions: counts must have numSymbols entries
+	 * Postconditions: returns the AnsTable, or nullptr if every count is
+	 * 0, more than 2^tableLog symbols occur, numSymbols is above 256 or
+	 * tableLog is out of range
+	 * @param counts: 64 bit frequencies for each symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param tableLog: log2 of the number of states
+	 * @return: shared pointer to the new AnsTable or nullptr
+	 */
+	static shared_ptr<const AnsTable> fromCounts(const uint64_t counts[],
+																int numSymbols,
+																int tableLog = DEFAULT_ANS_TABLE_LOG);
+
+	/**
+	 * fromNormalized
+	 * this function builds the tables from counts that already add up
+	 * to 2^tableLog
+	 * Preconditions: normalized must have numSymbols entries
+	 * Postconditions: returns the AnsTable, or nullptr if the counts do
+	 * not add up to 2^tableLog, numSymbols is above 256 or tableLog is
+	 * out of range
+	 * @param normalized: scaled frequencies for each symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param tableLog: log2 of the number of states
+	 * @return: shared pointer to the new AnsTable or nullptr
+	 */
+	static shared_ptr<const AnsTable> fromNormalized(const uint64_t normalized[],
+																	 int numSymbols, int tableLog);
+
+	/**
+	 * size, getTableLog, getNormalized
+	 * Preconditions: symbol must be between 0 and size() - 1
+	 * Postconditions: return the number of symbols, log2 of the number
+	 * of states and the scaled count of symbol (0 if it has no states)
+	 */
+	int size() const;
+	int getTableLog() const;
+	uint32_t getNormalized(int symbol) const;
+
+	/**
+	 * estimateBits
+	 * this function predicts the number of bits the symbols take: each
+	 * symbol costs log2(2^tableLog / normalized count) bits, plus the
+	 * final state
+	 * Preconditions: counts must have size() entries and every symbol
+	 * with a count must have states
+	 * Postconditions: returns the number of bits, rounded up
+	 * @param counts: 64 bit frequencies for each symbol
+	 * @return: number of bits
+	 */
+	uint64_t estimateBits(const uint64_t counts[]) const;
+
+	/**
+	 * encode
+	 * this function encodes the bytes from last to first, so the decoder
+	 * can read them first to last, and writes the final state followed
+	 * by the bits of each symbol
+	 * Preconditions: every byte must be a symbol with states
+	 * Postconditions: the coded bits are written to out
+	 * @param data: pointer to the bytes
+	 * @param size: number of bytes
+	 * @param out: BitWriter the bits are written to
+	 */
+	void encode(const uint8_t *data, size_t size, BitWriter &out) const;
+
+	/**
+	 * decode
+	 * this function reads count symbols from in and appends them to out
+	 * as bytes
+	 * Preconditions: none
+	 * Postconditions: returns false if the data ends early or does not
+	 * end in the state the encoder started from
+	 * @param in: BitReader positioned at the final encoder state
+	 * @param count: number of symbols to read
+	 * @param out: vector the bytes are appended to
+	 * @return: true if count symbols were read
+	 */
+	bool decode(BitReader &in, size_t count, vector<uint8_t> &out) const;
+
+	/**
+	 * serialize
+	 * this function writes the table log as a byte, the number of
+	 * symbols as a varint and the normalized counts as varints. After a
+	 * count of 0, a varint says how many more symbols have a count of 0
+	 * Preconditions: none
+	 * Postconditions: the bytes are appended to out
+	 * @param out: vector the bytes are appended to
+	 */
+	void serialize(vector<uint8_t> &out) const;
+
+	/**
+	 * deserialize
+	 * Preconditions: none
+	 * Postconditions: returns the AnsTable, or nullptr if the bytes are
+	 * malformed
+	 * @param data: pointer to the serialized table
+	 * @param size: number of bytes available
+	 * @param used: set to the number of bytes read
+	 * @return: the AnsTable or nullptr
+	 */
+	static shared_ptr<const AnsTable> deserialize(const uint8_t *data,
+																 size_t size, size_t &used);
+
+private:
+	/**
+	 * DecodeEntry struct is one state of the decode table: the symbol
+	 * it outputs, the number of bits to read, and the state those bits
+	 * are added to
+	 */
+	struct DecodeEntry
+	{
+		uint16_t nextBase = 0;
+		uint8_t symbol = 0;
+		uint8_t numBits = 0;
+	};
+
+	/**
+	 * SymbolEntry struct holds what the encoder needs for one symbol:
+	 * states with x >= threshold write maxBits bits, the others write
+	 * maxBits - 1, and start is where its states begin in encodeStates_
+	 */
+	struct SymbolEntry
+	{
+		uint32_t threshold = 0;
+		int maxBits = 0;
+		int start = 0;
+	};
+
+	AnsTable() = default;
+
+	int tableLog_ = 0;
+
+	// scaled count of each symbol, adding up to 2^tableLog_
+	vector<uint32_t> normalized_;
+
+	vector<DecodeEntry> decodeTable_;
+
+	vector<SymbolEntry> symbols_;
+
+	// encoder states in [2^tableLog_, 2^(tableLog_ + 1)) for each symbol
+	vector<uint16_t> encodeStates_;
+};
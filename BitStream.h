@@ -0,0 +1,244 @@
+/*
+ * @file BitStream.h
+ * @author Katarina McGaughy
+ * BitWriter and BitReader classes: The BitWriter class packs codes into
+ * bytes and the BitReader class reads them back. Bits are stored most
+ * significant bit first, so a code written as the string "110" is the
+ * same three bits in the packed stream.
+ *
+ * Features:
+ * -write up to 56 bits at once
+ * -read, peek and skip up to 56 bits at once
+ * -seek to any bit position (for checkpoints)
+ * -a BitWriter can fold a RunningCrc32c over its bytes as they are
+ *  written
+ *
+ * Assumptions:
+ * -bits past the end of the data read as 0, callers check remaining()
+ * -both classes are small and on the hot path, so they are declared
+ *  and defined here
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Crc32c.h"
+using namespace std;
+
+// most bits a single write, read or peek can handle
+const int MAX_BITS_PER_CALL = 56;
+
+class BitWriter
+{
+public:
+	/**
+	 * constructor
+	 * Preconditions: out and crc (if not nullptr) must outlive the
+	 * BitWriter
+	 * Postconditions: bytes are appended to the end of out, and folded
+	 * into crc as they are written
+	 * @param out: vector the packed bytes are appended to
+	 * @param crc: RunningCrc32c over out, or nullptr
+	 */
+	explicit BitWriter(vector<uint8_t> &out, RunningCrc32c *crc = nullptr)
+		: out_(out), crc_(crc)
+	{
+	}
+
+	/**
+	 * write
+	 * this function appends the low count bits of bits, most
+	 * significant first
+	 * Preconditions: count must be between 0 and MAX_BITS_PER_CALL
+	 * Postconditions: count bits are added to the stream
+	 * @param bits: bits to write, right aligned
+	 * @param count: number of bits to write
+	 */
+	void write(uint64_t bits, int count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		buffer_ = (buffer_ << count) | (bits & ((uint64_t(1) << count) - 1));
+		used_ += count;
+		total_ += count;
+		while (used_ >= 8)
+		{
+			used_ -= 8;
+			out_.push_back((uint8_t)(buffer_ >> used_));
+		}
+		if (crc_ != nullptr)
+		{
+			crc_->fold(out_.size());
+		}
+	}
+
+	/**
+	 * flush
+	 * this function pads the last partial byte with 0 bits
+	 * Preconditions: none
+	 * Postconditions: every bit written is in out
+	 */
+	void flush()
+	{
+		if (used_ > 0)
+		{
+			out_.push_back((uint8_t)(buffer_ << (8 - used_)));
+			total_ += 8 - used_;
+			used_ = 0;
+		}
+	}
+
+	/**
+	 * bitCount
+	 * Preconditions: none
+	 * Postconditions: returns the number of bits written so far
+	 * @return: number of bits written, including padding
+	 */
+	uint64_t bitCount() const
+	{
+		return total_;
+	}
+
+private:
+	vector<uint8_t> &out_;
+	RunningCrc32c *crc_;
+
+	// bits not yet stored in out_, right aligned
+	uint64_t buffer_ = 0;
+	int used_ = 0;
+
+	uint64_t total_ = 0;
+};
+
+class BitReader
+{
+public:
+	/**
+	 * constructor
+	 * Preconditions: data must stay valid while the BitReader is used
+	 * Postconditions: reader is positioned at bitOffset
+	 * @param data: pointer to the packed bytes
+	 * @param size: number of bytes
+	 * @param bitOffset: bit position to start reading from
+	 */
+	BitReader(const uint8_t *data, size_t size, uint64_t bitOffset = 0)
+		: data_(data), size_(size), pos_(bitOffset)
+	{
+	}
+
+	/**
+	 * peek
+	 * this function returns the next count bits without consuming them
+	 * Preconditions: count must be between 1 and MAX_BITS_PER_CALL
+	 * Postconditions: returns the bits right aligned, bits past the end
+	 * read as 0
+	 * @param count: number of bits to look at
+	 * @return: the next count bits
+	 */
+	uint64_t peek(int count) const
+	{
+		size_t byte = pos_ >> 3;
+		uint64_t window = 0;
+		if (byte + 8 <= size_)
+		{
+			for (int k = 0; k < 8; k++)
+			{
+				window = (window << 8) | data_[byte + k];
+			}
+		}
+		else
+		{
+			for (int k = 0; k < 8; k++)
+			{
+				window = (window << 8) | (byte + k < size_ ? data_[byte + k] : 0);
+			}
+		}
+		return (window << (pos_ & 7)) >> (64 - count);
+	}
+
+	/**
+	 * skip
+	 * Preconditions: none
+	 * Postconditions: position moves forward count bits
+	 * @param count: number of bits to skip
+	 */
+	void skip(uint64_t count)
+	{
+		pos_ += count;
+	}
+
+	/**
+	 * read
+	 * Preconditions: count must be between 1 and MAX_BITS_PER_CALL
+	 * Postconditions: returns the next count bits and consumes them
+	 * @param count: number of bits to read
+	 * @return: the bits read, right aligned
+	 */
+	uint64_t read(int count)
+	{
+		uint64_t bits = peek(count);
+		pos_ += count;
+		return bits;
+	}
+
+	/**
+	 * readBit
+	 * Preconditions: none
+	 * Postconditions: returns the next bit, or -1 if the data has ended
+	 * @return: 0, 1 or -1
+	 */
+	int readBit()
+	{
+		if (pos_ >= (uint64_t)size_ * 8)
+		{
+			return -1;
+		}
+		int bit = (data_[pos_ >> 3] >> (7 - (pos_ & 7))) & 1;
+		pos_++;
+		return bit;
+	}
+
+	/**
+	 * seek
+	 * Preconditions: none
+	 * Postconditions: reader is positioned at bitPosition
+	 * @param bitPosition: bit position from the start of the data
+	 */
+	void seek(uint64_t bitPosition)
+	{
+		pos_ = bitPosition;
+	}
+
+	/**
+	 * position, remaining
+	 * Preconditions: none
+	 * Postconditions: return the current bit position, and the number
+	 * of bits left (0 once the position is past the end)
+	 */
+	uint64_t position() const
+	{
+		return pos_;
+	}
+
+	uint64_t remaining() const
+	{
+		uint64_t total = (uint64_t)size_ * 8;
+		return pos_ >= total ? 0 : total - pos_;
+	}
+
+private:
+	const uint8_t *data_;
+	size_t size_;
+
+	// bit position of the next bit
+	uint64_t pos_;
+};
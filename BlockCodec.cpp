@@ -0,0 +1,777 @@
+/*
+ * @file BlockCodec.cpp
+ * @author Katarina McGaughy
+ * BlockCodec class: The BlockCodec class encodes a block of bytes into a
+ * self describing block and decodes it again. A block either carries its
+ * own codebook as a CodebookHeader, names a trained Dictionary by ID so
+ * short messages do not pay for a header, or carries several codebooks
+ * and a list of segments saying which codebook codes each part. Before
+ * coding, the exact coded size is predicted from the counts and code
+ * lengths, and blocks that would not shrink enough are stored raw. A
+ * TransformPipeline (such as move-to-front and zero run length) can run
+ * in front of the codebook, and the block names it so decode can undo
+ * it. A block with its own codebook can be coded with Huffman codes or
+ * with tANS (AnsTable), chosen by the caller or by whichever predicts
+ * the smaller block. Any block can be followed by a CRC-32C of its
+ * bytes, folded in as the block is written, so corruption is caught
+ * before its bytes are used.
+ *
+ * Block format:
+ * -mode byte (BLOCK_HEADER, BLOCK_DICTIONARY, BLOCK_MULTI_TABLE,
+ *  BLOCK_RAW, BLOCK_TRANSFORMED or BLOCK_ANS), with BLOCK_CHECKSUM_FLAG
+ *  set if the block has a checksum
+ * -BLOCK_HEADER: CodebookHeader for the 256 byte values, then the
+ *  number of bytes in the block as a varint
+ * -BLOCK_DICTIONARY: dictionary ID as a varint, then the number of bytes
+ *  in the block as a varint
+ * -BLOCK_MULTI_TABLE: number of codebooks as a varint, a CodebookHeader
+ *  for each, the number of segments as a varint, and for each segment
+ *  its length as a varint and its codebook index as a byte
+ * -BLOCK_RAW: number of bytes as a varint, then the bytes themselves,
+ *  with no packed codes
+ * -BLOCK_TRANSFORMED: number of bytes before the transforms as a varint,
+ *  the TransformPipeline, then a BLOCK_HEADER, BLOCK_ANS or BLOCK_RAW
+ *  block of the transformed bytes
+ * -BLOCK_ANS: serialized AnsTable, then the number of bytes in the
+ *  block as a varint, then the tANS coded bits
+ * -packed codes, padded to a whole byte
+ * -with BLOCK_CHECKSUM_FLAG: CRC-32C of every byte above, 4 bytes with
+ *  the low byte first
+ *
+ * Assumptions:
+ * -blocks can be stored back to back, decode reports the size of each
+ * -with minSavings of at least 0, a block is never larger than the
+ *  BLOCK_RAW block of the same bytes
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "BlockCodec.h"
+#include "BitStream.h"
+#include "CodebookHeader.h"
+#include "Crc32c.h"
+#include "KernelCodec.h"
+#include "Varint.h"
+
+/**
+ * encode
+ * this function counts the bytes in data, builds a Huffman codebook
+ * or AnsTable from the counts and writes a block that carries it, or
+ * a raw block if coding would not save minSavings of the raw size.
+ * CODER_AUTO picks the coder that predicts the smaller block
+ * Preconditions: none
+ * Postconditions: the block is appended to out
+ * @param data: pointer to the bytes to encode
+ * @param size: number of bytes
+ * @param out: vector the block is appended to
+ * @param minSavings: fraction of the raw size coding must save
+ * @param coder: entropy coder to use
+ * @param checksum: whether to follow the block with its CRC-32C
+ */
+void BlockCodec::encode(const uint8_t *data, size_t size, vector<uint8_t> &out,
+								double minSavings, EntropyCoder coder, bool checksum)
+{
+	RunningCrc32c crc(out, out.size());
+	encodeBlock(data, size, out, minSavings, coder, checksum ? &crc : nullptr);
+	if (checksum)
+	{
+		appendChecksum(out, crc);
+	}
+}
+
+/**
+ * encodeBlock
+ * this function writes the block for encode. With crc, the mode byte
+ * is marked as checked and the bytes are folded into crc as they are
+ * written, leaving the checksum itself to encode
+ * Preconditions: as for encode, crc (if not nullptr) must start at
+ * the end of out
+ * Postconditions: the block is appended to out
+ */
+void BlockCodec::encodeBlock(const uint8_t *data, size_t size,
+									  vector<uint8_t> &out, double minSavings,
+									  EntropyCoder coder, RunningCrc32c *crc)
+{
+	size_t start = out.size();
+	uint8_t checked = crc != nullptr ? BLOCK_CHECKSUM_FLAG : 0;
+	uint64_t counts[NUM_BYTE_SYMBOLS] = {};
+	for (size_t i = 0; i < size; i++)
+	{
+		counts[data[i]]++;
+	}
+	int lengths[NUM_BYTE_SYMBOLS];
+	vector<uint8_t> header;
+	CodebookHeader::fromCounts(counts, NUM_BYTE_SYMBOLS, lengths, header);
+	uint64_t codedBytes = 1 + header.size() + varintSize(size) +
+								 (estimateBits(counts, lengths, NUM_BYTE_SYMBOLS) + 7) / 8;
+
+	// tANS pays for a larger header, so it wins on skewed blocks where
+	// Huffman spends close to a whole bit on the common symbol
+	shared_ptr<const AnsTable> ansTable;
+	vector<uint8_t> ansHeader;
+	uint64_t ansBytes = 0;
+	if (coder != CODER_HUFFMAN)
+	{
+		ansTable = AnsTable::fromCounts(counts, NUM_BYTE_SYMBOLS);
+	}
+	if (ansTable)
+	{
+		ansTable->serialize(ansHeader);
+		ansBytes = 1 + ansHeader.size() + varintSize(size) +
+					  (ansTable->estimateBits(counts) + 7) / 8;
+		if (coder == CODER_ANS || ansBytes < codedBytes)
+		{
+			codedBytes = ansBytes;
+		}
+		else
+		{
+			ansTable.reset();
+		}
+	}
+
+	// skip coding blocks that would not shrink
+	if (!worthCoding(codedBytes, size, minSavings))
+	{
+		encodeRaw(data, size, out, crc);
+		return;
+	}
+
+	if (ansTable)
+	{
+		out.push_back(BLOCK_ANS | checked);
+		out.insert(out.end(), ansHeader.begin(), ansHeader.end());
+		writeVarint(size, out);
+		BitWriter writer(out, crc);
+		ansTable->encode(data, size, writer);
+		writer.flush();
+
+		// the tANS estimate is fractional, so the block can come out
+		// larger than the raw block it was meant to beat
+		if (out.size() - start > 1 + varintSize(size) + size)
+		{
+			out.resize(start);
+			if (crc != nullptr)
+			{
+				crc->restart();
+			}
+			encodeRaw(data, size, out, crc);
+		}
+		return;
+	}
+
+	out.push_back(BLOCK_HEADER | checked);
+	out.insert(out.end(), header.begin(), header.end());
+	writeVarint(size, out);
+
+	shared_ptr<const CodeTable> table =
+		 CodeTable::fromLengths(lengths, NUM_BYTE_SYMBOLS, 0);
+	if (size >= MIN_KERNEL_SYMBOLS)
+	{
+		KernelCodec(table).encode(data, size, out, crc);
+		return;
+	}
+	BitWriter writer(out, crc);
+	table->encode(data, size, writer);
+	writer.flush();
+}
+
+/**
+ * encode
+ * this function writes a block coded with a trained dictionary that
+ * refers to it by ID, or a raw block if coding would not save
+ * minSavings of the raw size
+ * Preconditions: every byte in data must have a code in dictionary
+ * Postconditions: the block is appended to out
+ * @param data: pointer to the bytes to encode
+ * @param size: number of bytes
+ * @param dictionary: dictionary to code with
+ * @param out: vector the block is appended to
+ * @param minSavings: fraction of the raw size coding must save
+ * @param checksum: whether to follow the block with its CRC-32C
+ */
+void BlockCodec::encode(const uint8_t *data, size_t size,
+								const Dictionary &dictionary, vector<uint8_t> &out,
+								double minSavings, bool checksum)
+{
+	RunningCrc32c crc(out, out.size());
+	encodeBlock(data, size, dictionary, out, minSavings,
+					checksum ? &crc : nullptr);
+	if (checksum)
+	{
+		appendChecksum(out, crc);
+	}
+}
+
+/**
+ * encodeBlock
+ * this function writes the dictionary block for encode, folding it
+ * into crc as the other encodeBlock does
+ * Preconditions: as for encode, crc (if not nullptr) must start at
+ * the end of out
+ * Postconditions: the block is appended to out
+ */
+void BlockCodec::encodeBlock(const uint8_t *data, size_t size,
+									  const Dictionary &dictionary, vector<uint8_t> &out,
+									  double minSavings, RunningCrc32c *crc)
+{
+	uint64_t counts[NUM_BYTE_SYMBOLS] = {};
+	int lengths[NUM_BYTE_SYMBOLS];
+	for (size_t i = 0; i < size; i++)
+	{
+		counts[data[i]]++;
+	}
+	for (int s = 0; s < NUM_BYTE_SYMBOLS; s++)
+	{
+		lengths[s] = dictionary.getLength(s);
+	}
+	uint64_t codedBytes = 1 + varintSize(dictionary.getId()) + varintSize(size) +
+								 (estimateBits(counts, lengths, NUM_BYTE_SYMBOLS) + 7) / 8;
+	if (!worthCoding(codedBytes, size, minSavings))
+	{
+		encodeRaw(data, size, out, crc);
+		return;
+	}
+
+	out.push_back(BLOCK_DICTIONARY |
+					  (crc != nullptr ? BLOCK_CHECKSUM_FLAG : 0));
+	writeVarint(dictionary.getId(), out);
+	writeVarint(size, out);
+
+	BitWriter writer(out, crc);
+	dictionary.getCodeTable().encode(data, size, writer);
+	writer.flush();
+}
+
+/**
+ * encodeSplit
+ * this function plans segments and up to maxTables codebooks with
+ * BlockSplitter and writes a BLOCK_MULTI_TABLE block, or a raw block
+ * if the plan would not save minSavings of the raw size
+ * Preconditions: maxTables must be between 1 and MAX_BLOCK_TABLES
+ * Postconditions: the block is appended to out
+ * @param data: pointer to the bytes to encode
+ * @param size: number of bytes
+ * @param out: vector the block is appended to
+ * @param maxTables: most codebooks to use
+ * @param minSavings: fraction of the raw size coding must save
+ * @param checksum: whether to follow the block with its CRC-32C
+ */
+void BlockCodec::encodeSplit(const uint8_t *data, size_t size,
+									  vector<uint8_t> &out, int maxTables,
+									  double minSavings, bool checksum)
+{
+	size_t start = out.size();
+	RunningCrc32c crc(out, start);
+	RunningCrc32c *folding = checksum ? &crc : nullptr;
+	BlockSplitter splitter(data, size, maxTables);
+	if (!worthCoding(2 + (splitter.getCostBits() + 7) / 8, size, minSavings))
+	{
+		encodeRaw(data, size, out, folding);
+		if (checksum)
+		{
+			appendChecksum(out, crc);
+		}
+		return;
+	}
+
+	out.push_back(BLOCK_MULTI_TABLE | (checksum ? BLOCK_CHECKSUM_FLAG : 0));
+	writeVarint(splitter.getNumTables(), out);
+	vector<shared_ptr<const CodeTable>> tables;
+	for (int t = 0; t < splitter.getNumTables(); t++)
+	{
+		CodebookHeader::write(splitter.getLengths(t), NUM_BYTE_SYMBOLS, out);
+		tables.push_back(CodeTable::fromLengths(splitter.getLengths(t),
+															 NUM_BYTE_SYMBOLS, 0));
+	}
+	const vector<BlockSplitter::Segment> &segments = splitter.getSegments();
+	writeVarint(segments.size(), out);
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		writeVarint(segments[i].length, out);
+		out.push_back(segments[i].table);
+	}
+
+	BitWriter writer(out, folding);
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		tables[segments[i].table]->encode(data, segments[i].length, writer);
+		data += segments[i].length;
+	}
+	writer.flush();
+
+	// the plan's cost is an estimate, so check the block against the raw
+	// block it was meant to beat
+	if (out.size() - start > 1 + varintSize(size) + size)
+	{
+		out.resize(start);
+		crc.restart();
+		encodeRaw(data - size, size, out, folding);
+	}
+	if (checksum)
+	{
+		appendChecksum(out, crc);
+	}
+}
+
+/**
+ * encodeTransformed
+ * this function runs pipeline over data and writes a block that
+ * names the pipeline and holds the transformed bytes, coded with
+ * their own codebook or stored raw. If that block is not smaller
+ * than the one encode writes for data as it is, the plain block is
+ * written instead
+ * Preconditions: pipeline must hold at most MAX_TRANSFORMS transforms
+ * Postconditions: the block is appended to out
+ * @param data: pointer to the bytes to encode
+ * @param size: number of bytes
+ * @param pipeline: transforms to run before coding
+ * @param out: vector the block is appended to
+ * @param minSavings: fraction of the raw size coding must save
+ * @param checksum: whether to follow the block with its CRC-32C
+ */
+void BlockCodec::encodeTransformed(const uint8_t *data, size_t size,
+											  const TransformPipeline &pipeline,
+											  vector<uint8_t> &out, double minSavings,
+											  bool checksum)
+{
+	vector<uint8_t> transformed;
+	pipeline.forward(data, size, transformed);
+
+	vector<uint8_t> block;
+	block.push_back(BLOCK_TRANSFORMED);
+	writeVarint(size, block);
+	pipeline.serialize(block);
+	// the codebook is built from the histogram of the transformed bytes
+	encodeBlock(transformed.data(), transformed.size(), block, minSavings,
+					CODER_AUTO, nullptr);
+
+	// a transform can spread the histogram out or grow the data, so
+	// keep the plain block unless the transform paid for itself
+	vector<uint8_t> plain;
+	encodeBlock(data, size, plain, minSavings, CODER_AUTO, nullptr);
+	vector<uint8_t> &chosen = plain.size() <= block.size() ? plain : block;
+
+	// both candidates are written before one is picked, so the checksum
+	// is folded in while the pick is copied to out
+	RunningCrc32c crc(out, out.size());
+	if (checksum)
+	{
+		chosen[0] |= BLOCK_CHECKSUM_FLAG;
+	}
+	appendBytes(chosen.data(), chosen.size(), out, checksum ? &crc : nullptr);
+	if (checksum)
+	{
+		appendChecksum(out, crc);
+	}
+}
+
+/**
+ * appendChecksum
+ * this function folds in the last bytes of the block and appends
+ * its CRC-32C, 4 bytes with the low byte first
+ * Preconditions: crc must cover the block that out ends with
+ * Postconditions: the checksum is appended to out
+ * @param out: vector holding the block
+ * @param crc: RunningCrc32c over the block
+ */
+void BlockCodec::appendChecksum(vector<uint8_t> &out, RunningCrc32c &crc)
+{
+	uint32_t value = crc.finish(out.size());
+	for (int k = 0; k < 4; k++)
+	{
+		out.push_back((uint8_t)(value >> (8 * k)));
+	}
+}
+
+/**
+ * appendBytes
+ * this function copies bytes to out CRC_FOLD_BYTES at a time and
+ * folds each copy into crc while it is still in the cache
+ * Preconditions: crc (if not nullptr) must cover the bytes of out
+ * Postconditions: the bytes are appended to out
+ */
+void BlockCodec::appendBytes(const uint8_t *data, size_t size,
+									  vector<uint8_t> &out, RunningCrc32c *crc)
+{
+	if (crc == nullptr)
+	{
+		out.insert(out.end(), data, data + size);
+		return;
+	}
+	for (size_t done = 0; done < size; done += CRC_FOLD_BYTES)
+	{
+		size_t count = size - done < CRC_FOLD_BYTES ? size - done : CRC_FOLD_BYTES;
+		out.insert(out.end(), data + done, data + done + count);
+		crc->fold(out.size());
+	}
+}
+
+/**
+ * estimateBits
+ * this function predicts the exact number of bits the codes take:
+ * the sum of count x code length over all symbols
+ * Preconditions: every symbol with a count must have a length
+ * Postconditions: returns the number of code bits
+ * @param counts: 64 bit frequencies for each symbol
+ * @param lengths: integer array of code lengths for each symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @return: number of code bits
+ */
+uint64_t BlockCodec::estimateBits(const uint64_t counts[],
+											 const int lengths[],
+											 int numSymbols)
+{
+	uint64_t bits = 0;
+	for (int s = 0; s < numSymbols; s++)
+	{
+		bits += counts[s] * lengths[s];
+	}
+	return bits;
+}
+
+/**
+ * worthCoding
+ * Preconditions: none
+ * Postconditions: returns true if a coded block of codedBytes saves
+ * at least minSavings of the raw block for size bytes
+ * @param codedBytes: predicted size of the coded block
+ * @param size: number of bytes in the block
+ * @param minSavings: fraction of the raw size coding must save
+ * @return: true if the block should be coded
+ */
+bool BlockCodec::worthCoding(uint64_t codedBytes, size_t size,
+									  double minSavings)
+{
+	uint64_t rawBytes = 1 + varintSize(size) + size;
+	return codedBytes <= rawBytes - (uint64_t)(rawBytes * minSavings);
+}
+
+/**
+ * encodeRaw
+ * Preconditions: crc (if not nullptr) must start at the end of out
+ * Postconditions: a BLOCK_RAW block with data is appended to out,
+ * marked as checked and folded into crc if crc is given
+ */
+void BlockCodec::encodeRaw(const uint8_t *data, size_t size,
+									vector<uint8_t> &out, RunningCrc32c *crc)
+{
+	out.push_back(BLOCK_RAW | (crc != nullptr ? BLOCK_CHECKSUM_FLAG : 0));
+	writeVarint(size, out);
+	appendBytes(data, size, out, crc);
+}
+
+/**
+ * decode
+ * this function decodes one block and appends its bytes to out
+ * Preconditions: none
+ * Postconditions: returns the size of the block in bytes, or 0 if
+ * the block is malformed, names a dictionary not in dictionaries or
+ * does not match its checksum. out is unchanged when 0 is returned
+ * @param data: pointer to the start of the block
+ * @param size: number of bytes available
+ * @param dictionaries: dictionaries the block may refer to
+ * @param out: vector the decoded bytes are appended to
+ * @return: number of bytes in the block, 0 on error
+ */
+size_t BlockCodec::decode(const uint8_t *data, size_t size,
+								  const DictionarySet &dictionaries,
+								  vector<uint8_t> &out)
+{
+	if (size == 0)
+	{
+		return 0;
+	}
+	size_t start = out.size();
+	size_t used = decodeBlock(data, size, dictionaries, out);
+
+	// the checksum covers the block as stored, mode byte included
+	if (used > 0 && (data[0] & BLOCK_CHECKSUM_FLAG) != 0)
+	{
+		uint32_t stored = 0;
+		for (int k = 0; k < 4 && used + k < size; k++)
+		{
+			stored |= (uint32_t)data[used + k] << (8 * k);
+		}
+		if (size - used >= 4 && stored == crc32c(data, used))
+		{
+			used += 4;
+		}
+		else
+		{
+			used = 0;
+		}
+	}
+
+	// the block decoders append as they go, so a block that fails part
+	// way is taken back out here
+	if (used == 0)
+	{
+		out.resize(start);
+	}
+	return used;
+}
+
+/**
+ * decodeBlock
+ * this function decodes one block, leaving its checksum to decode
+ * Preconditions: size must be at least 1
+ * Postconditions: returns the size of the block in bytes without
+ * its checksum, or 0 on error, when out may hold part of the block
+ */
+size_t BlockCodec::decodeBlock(const uint8_t *data, size_t size,
+										 const DictionarySet &dictionaries,
+										 vector<uint8_t> &out)
+{
+	uint8_t mode = data[0] & ~BLOCK_CHECKSUM_FLAG;
+	size_t pos = 1;
+
+	// find the codebook
+	shared_ptr<const CodeTable> ownTable;
+	const CodeTable *table = nullptr;
+	if (mode == BLOCK_HEADER)
+	{
+		int lengths[NUM_BYTE_SYMBOLS];
+		int numSymbols = 0;
+		size_t used = CodebookHeader::read(data + pos, size - pos, lengths,
+													  NUM_BYTE_SYMBOLS, numSymbols);
+		if (used == 0)
+		{
+			return 0;
+		}
+		pos += used;
+		ownTable = CodeTable::fromLengths(lengths, numSymbols, 0);
+		table = ownTable.get();
+	}
+	else if (mode == BLOCK_DICTIONARY)
+	{
+		uint64_t id = 0;
+		size_t used = readVarint(data + pos, size - pos, id);
+		if (used == 0 || id > UINT32_MAX)
+		{
+			return 0;
+		}
+		auto found = dictionaries.find((uint32_t)id);
+		if (found == dictionaries.end())
+		{
+			return 0;
+		}
+		pos += used;
+		table = &found->second->getCodeTable();
+	}
+	else if (mode == BLOCK_MULTI_TABLE)
+	{
+		return decodeMultiTable(data, size, out);
+	}
+	else if (mode == BLOCK_TRANSFORMED)
+	{
+		return decodeTransformed(data, size, out);
+	}
+	else if (mode == BLOCK_ANS)
+	{
+		return decodeAns(data, size, out);
+	}
+	else if (mode == BLOCK_RAW)
+	{
+		uint64_t count = 0;
+		size_t used = readVarint(data + pos, size - pos, count);
+		if (used == 0 || count > size - pos - used)
+		{
+			return 0;
+		}
+		pos += used;
+		out.insert(out.end(), data + pos, data + pos + count);
+		return pos + count;
+	}
+	else
+	{
+		return 0;
+	}
+
+	uint64_t count = 0;
+	size_t used = readVarint(data + pos, size - pos, count);
+	if (used == 0)
+	{
+		return 0;
+	}
+	pos += used;
+
+	// a block's own codebook is only used once, so the kernel tables
+	// are only worth filling for larger blocks
+	if (ownTable && count >= MIN_KERNEL_SYMBOLS)
+	{
+		uint64_t bitsRead = 0;
+		if (!KernelCodec(ownTable).decode(data + pos, size - pos, count, out,
+													 bitsRead))
+		{
+			return 0;
+		}
+		return pos + (bitsRead + 7) / 8;
+	}
+	BitReader reader(data + pos, size - pos);
+	if (!table->decode(reader, count, out))
+	{
+		return 0;
+	}
+	return pos + (reader.position() + 7) / 8;
+}
+
+/**
+ * decodeMultiTable
+ * this function decodes a BLOCK_MULTI_TABLE block, switching codebooks
+ * at each segment boundary
+ * Preconditions: data[0] must be BLOCK_MULTI_TABLE
+ * Postconditions: returns the size of the block in bytes, or 0 if the
+ * block is malformed
+ * @param data: pointer to the start of the block
+ * @param size: number of bytes available
+ * @param out: vector the decoded bytes are appended to
+ * @return: number of bytes in the block, 0 on error
+ */
+size_t BlockCodec::decodeMultiTable(const uint8_t *data, size_t size,
+												vector<uint8_t> &out)
+{
+	size_t pos = 1;
+	uint64_t numTables = 0;
+	size_t used = readVarint(data + pos, size - pos, numTables);
+	if (used == 0 || numTables == 0 || numTables > MAX_BLOCK_TABLES)
+	{
+		return 0;
+	}
+	pos += used;
+
+	vector<shared_ptr<const CodeTable>> tables;
+	for (uint64_t t = 0; t < numTables; t++)
+	{
+		int lengths[NUM_BYTE_SYMBOLS];
+		int numSymbols = 0;
+		used = CodebookHeader::read(data + pos, size - pos, lengths,
+											 NUM_BYTE_SYMBOLS, numSymbols);
+		if (used == 0)
+		{
+			return 0;
+		}
+		pos += used;
+		tables.push_back(CodeTable::fromLengths(lengths, numSymbols, 0));
+	}
+
+	uint64_t numSegments = 0;
+	used = readVarint(data + pos, size - pos, numSegments);
+	if (used == 0)
+	{
+		return 0;
+	}
+	pos += used;
+	vector<BlockSplitter::Segment> segments;
+	for (uint64_t i = 0; i < numSegments; i++)
+	{
+		uint64_t length = 0;
+		used = readVarint(data + pos, size - pos, length);
+		if (used == 0 || pos + used >= size || data[pos + used] >= numTables)
+		{
+			return 0;
+		}
+		BlockSplitter::Segment segment;
+		segment.length = length;
+		segment.table = data[pos + used];
+		segments.push_back(segment);
+		pos += used + 1;
+	}
+
+	BitReader reader(data + pos, size - pos);
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		if (!tables[segments[i].table]->decode(reader, segments[i].length, out))
+		{
+			return 0;
+		}
+	}
+	return pos + (reader.position() + 7) / 8;
+}
+
+/**
+ * decodeTransformed
+ * this function decodes the inner block of a BLOCK_TRANSFORMED block
+ * and runs the inverse of its pipeline
+ * Preconditions: data[0] must be BLOCK_TRANSFORMED
+ * Postconditions: returns the size of the block in bytes, or 0 if the
+ * block is malformed
+ * @param data: pointer to the start of the block
+ * @param size: number of bytes available
+ * @param out: vector the decoded bytes are appended to
+ * @return: number of bytes in the block, 0 on error
+ */
+size_t BlockCodec::decodeTransformed(const uint8_t *data, size_t size,
+												 vector<uint8_t> &out)
+{
+	size_t pos = 1;
+	uint64_t originalSize = 0;
+	size_t used = readVarint(data + pos, size - pos, originalSize);
+	if (used == 0)
+	{
+		return 0;
+	}
+	pos += used;
+	TransformPipeline pipeline;
+	used = TransformPipeline::deserialize(data + pos, size - pos, pipeline);
+	if (used == 0)
+	{
+		return 0;
+	}
+	pos += used;
+
+	// the inner block carries its own codebook or is raw
+	if (pos == size || (data[pos] != BLOCK_HEADER && data[pos] != BLOCK_ANS &&
+							  data[pos] != BLOCK_RAW))
+	{
+		return 0;
+	}
+	vector<uint8_t> transformed;
+	used = decode(data + pos, size - pos, DictionarySet(), transformed);
+	if (used == 0 || !pipeline.inverse(transformed.data(), transformed.size(),
+												  originalSize, out))
+	{
+		return 0;
+	}
+	return pos + used;
+}
+
+/**
+ * decodeAns
+ * Preconditions: data[0] must be BLOCK_ANS
+ * Postconditions: returns the size of the block in bytes, or 0 if the
+ * block is malformed
+ * @param data: pointer to the start of the block
+ * @param size: number of bytes available
+ * @param out: vector the decoded bytes are appended to
+ * @return: number of bytes in the block, 0 on error
+ */
+size_t BlockCodec::decodeAns(const uint8_t *data, size_t size,
+									  vector<uint8_t> &out)
+{
+	size_t pos = 1;
+	size_t used = 0;
+	shared_ptr<const AnsTable> table =
+		 AnsTable::deserialize(data + pos, size - pos, used);
+	if (!table)
+	{
+		return 0;
+	}
+	pos += used;
+	uint64_t count = 0;
+	used = readVarint(data + pos, size - pos, count);
+	if (used == 0)
+	{
+		return 0;
+	}
+	pos += used;
+
+	BitReader reader(data + pos, size - pos);
+	if (!table->decode(reader, count, out))
+	{
+		return 0;
+	}
+	return pos + (reader.position() + 7) / 8;
+}
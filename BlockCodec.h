@@ -0,0 +1,315 @@
+/*
+ * @file BlockCodec.h
+ * @author Katarina McGaughy
+ * BlockCodec class: The BlockCodec class encodes a block of bytes into a
+ * self describing block and decodes it again. A block either carries its
+ * own codebook as a CodebookHeader, names a trained Dictionary by ID so
+ * short messages do not pay for a header, or carries several codebooks
+ * and a list of segments saying which codebook codes each part. Before
+ * coding, the exact coded size is predicted from the counts and code
+ * lengths, and blocks that would not shrink enough are stored raw. A
+ * TransformPipeline (such as move-to-front and zero run length) can run
+ * in front of the codebook, and the block names it so decode can undo
+ * it. A block with its own codebook can be coded with Huffman codes or
+ * with tANS (AnsTable), chosen by the caller or by whichever predicts
+ * the smaller block. Any block can be followed by a CRC-32C of its
+ * bytes, folded in as the block is written, so corruption is caught
+ * before its bytes are used.
+ *
+ * Block format:
+ * -mode byte (BLOCK_HEADER, BLOCK_DICTIONARY, BLOCK_MULTI_TABLE,
+ *  BLOCK_RAW, BLOCK_TRANSFORMED or BLOCK_ANS), with BLOCK_CHECKSUM_FLAG
+ *  set if the block has a checksum
+ * -BLOCK_HEADER: CodebookHeader for the 256 byte values, then the
+ *  number of bytes in the block as a varint
+ * -BLOCK_DICTIONARY: dictionary ID as a varint, then the number of bytes
+ *  in the block as a varint
+ * -BLOCK_MULTI_TABLE: number of codebooks as a varint, a CodebookHeader
+ *  for each, the number of segments as a varint, and for each segment
+ *  its length as a varint and its codebook index as a byte
+ * -BLOCK_RAW: number of bytes as a varint, then the bytes themselves,
+ *  with no packed codes
+ * -BLOCK_TRANSFORMED: number of bytes before the transforms as a varint,
+ *  the TransformPipeline, then a BLOCK_HEADER, BLOCK_ANS or BLOCK_RAW
+ *  block of the transformed bytes
+ * -BLOCK_ANS: serialized AnsTable, then the number of bytes in the
+ *  block as a varint, then the tANS coded bits
+ * -packed codes, padded to a whole byte
+ * -with BLOCK_CHECKSUM_FLAG: CRC-32C of every byte above, 4 bytes with
+ *  the low byte first
+ *
+ * Assumptions:
+ * -blocks can be stored back to back, decode reports the size of each
+ * -with minSavings of at least 0, a block is never larger than the
+ *  BLOCK_RAW block of the same bytes
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AnsTable.h"
+#include "BlockSplitter.h"
+#include "Crc32c.h"
+#include "Dictionary.h"
+#include "TransformPipeline.h"
+using namespace std;
+
+// first byte of a block, says where its codebook comes from
+enum BlockMode : uint8_t
+{
+	BLOCK_HEADER = 0,
+	BLOCK_DICTIONARY = 1,
+	BLOCK_MULTI_TABLE = 2,
+	BLOCK_RAW = 3,
+	BLOCK_TRANSFORMED = 4,
+	BLOCK_ANS = 5
+};
+
+// set in the mode byte when a CRC-32C follows the block
+const uint8_t BLOCK_CHECKSUM_FLAG = 0x80;
+
+// entropy coder for a block that carries its own codebook
+enum EntropyCoder
+{
+	CODER_AUTO,
+	CODER_HUFFMAN,
+	CODER_ANS
+};
+
+// fraction of the raw size a coded block must save, or it is stored raw
+const double DEFAULT_MIN_SAVINGS = 0.02;
+
+class BlockCodec
+{
+public:
+	/**
+	 * encode
+	 * this function counts the bytes in data, builds a Huffman codebook
+	 * or AnsTable from the counts and writes a block that carries it, or
+	 * a raw block if coding would not save minSavings of the raw size.
+	 * CODER_AUTO picks the coder that predicts the smaller block
+	 * Preconditions: none
+	 * Postconditions: the block is appended to out
+	 * @param data: pointer to the bytes to encode
+	 * @param size: number of bytes
+	 * @param out: vector the block is appended to
+	 * @param minSavings: fraction of the raw size coding must save
+	 * @param coder: entropy coder to use
+	 * @param checksum: whether to follow the block with its CRC-32C
+	 */
+	static void encode(const uint8_t *data, size_t size, vector<uint8_t> &out,
+							 double minSavings = DEFAULT_MIN_SAVINGS,
+							 EntropyCoder coder = CODER_AUTO, bool checksum = false);
+
+	/**
+	 * encode
+	 * this function writes a block coded with a trained dictionary that
+	 * refers to it by ID, or a raw block if coding would not save
+	 * minSavings of the raw size
+	 * Preconditions: every byte in data must have a code in dictionary
+	 * Postconditions: the block is appended to out
+	 * @param data: pointer to the bytes to encode
+	 * @param size: number of bytes
+	 * @param dictionary: dictionary to code with
+	 * @param out: vector the block is appended to
+	 * @param minSavings: fraction of the raw size coding must save
+	 * @param checksum: whether to follow the block with its CRC-32C
+	 */
+	static void encode(const uint8_t *data, size_t size,
+							 const Dictionary &dictionary, vector<uint8_t> &out,
+							 double minSavings = DEFAULT_MIN_SAVINGS,
+							 bool checksum = false);
+
+	/**
+	 * encodeSplit
+	 * this function plans segments and up to maxTables codebooks with
+	 * BlockSplitter and writes a BLOCK_MULTI_TABLE block, or a raw block
+	 * if the plan would not save minSavings of the raw size
+	 * Preconditions: maxTables must be between 1 and MAX_BLOCK_TABLES
+	 * Postconditions: the block is appended to out
+	 * @param data: pointer to the bytes to encode
+	 * @param size: number of bytes
+	 * @param out: vector the block is appended to
+	 * @param maxTables: most codebooks to use
+	 * @param minSavings: fraction of the raw size coding must save
+	 * @param checksum: whether to follow the block with its CRC-32C
+	 */
+	static void encodeSplit(const uint8_t *data, size_t size,
+									vector<uint8_t> &out,
+									int maxTables = MAX_BLOCK_TABLES,
+									double minSavings = DEFAULT_MIN_SAVINGS,
+									bool checksum = false);
+
+	/**
+	 * encodeTransformed
+	 * this function runs pipeline over data and writes a block that
+	 * names the pipeline and holds the transformed bytes, coded with
+	 * their own codebook or stored raw. If that block is not smaller
+	 * than the one encode writes for data as it is, the plain block is
+	 * written instead
+	 * Preconditions: pipeline must hold at most MAX_TRANSFORMS transforms
+	 * Postconditions: the block is appended to out
+	 * @param data: pointer to the bytes to encode
+	 * @param size: number of bytes
+	 * @param pipeline: transforms to run before coding
+	 * @param out: vector the block is appended to
+	 * @param minSavings: fraction of the raw size coding must save
+	 * @param checksum: whether to follow the block with its CRC-32C
+	 */
+	static void encodeTransformed(const uint8_t *data, size_t size,
+											const TransformPipeline &pipeline,
+											vector<uint8_t> &out,
+											double minSavings = DEFAULT_MIN_SAVINGS,
+											bool checksum = false);
+
+	/**
+	 * estimateBits
+	 * this function predicts the exact number of bits the codes take:
+	 * the sum of count x code length over all symbols
+	 * Preconditions: every symbol with a count must have a length
+	 * Postconditions: returns the number of code bits
+	 * @param counts: 64 bit frequencies for each symbol
+	 * @param lengths: integer array of code lengths for each symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @return: number of code bits
+	 */
+	static uint64_t estimateBits(const uint64_t counts[], const int lengths[],
+										  int numSymbols);
+
+	/**
+	 * worthCoding
+	 * Preconditions: none
+	 * Postconditions: returns true if a coded block of codedBytes saves
+	 * at least minSavings of the raw block for size bytes
+	 * @param codedBytes: predicted size of the coded block
+	 * @param size: number of bytes in the block
+	 * @param minSavings: fraction of the raw size coding must save
+	 * @return: true if the block should be coded
+	 */
+	static bool worthCoding(uint64_t codedBytes, size_t size, double minSavings);
+
+	/**
+	 * decode
+	 * this function decodes one block and appends its bytes to out
+	 * Preconditions: none
+	 * Postconditions: returns the size of the block in bytes, or 0 if
+	 * the block is malformed, names a dictionary not in dictionaries or
+	 * does not match its checksum. out is unchanged when 0 is returned
+	 * @param data: pointer to the start of the block
+	 * @param size: number of bytes available
+	 * @param dictionaries: dictionaries the block may refer to
+	 * @param out: vector the decoded bytes are appended to
+	 * @return: number of bytes in the block, 0 on error
+	 */
+	static size_t decode(const uint8_t *data, size_t size,
+								const DictionarySet &dictionaries,
+								vector<uint8_t> &out);
+
+private:
+	/**
+	 * encodeBlock
+	 * this function writes the block for encode. With crc, the mode byte
+	 * is marked as checked and the bytes are folded into crc as they are
+	 * written, leaving the checksum itself to encode
+	 * Preconditions: as for encode, crc (if not nullptr) must start at
+	 * the end of out
+	 * Postconditions: the block is appended to out
+	 */
+	static void encodeBlock(const uint8_t *data, size_t size,
+									vector<uint8_t> &out, double minSavings,
+									EntropyCoder coder, RunningCrc32c *crc);
+	static void encodeBlock(const uint8_t *data, size_t size,
+									const Dictionary &dictionary, vector<uint8_t> &out,
+									double minSavings, RunningCrc32c *crc);
+
+	/**
+	 * appendChecksum
+	 * this function folds in the last bytes of the block and appends
+	 * its CRC-32C, 4 bytes with the low byte first
+	 * Preconditions: crc must cover the block that out ends with
+	 * Postconditions: the checksum is appended to out
+	 * @param out: vector holding the block
+	 * @param crc: RunningCrc32c over the block
+	 */
+	static void appendChecksum(vector<uint8_t> &out, RunningCrc32c &crc);
+
+	/**
+	 * appendBytes
+	 * this function copies bytes to out CRC_FOLD_BYTES at a time and
+	 * folds each copy into crc while it is still in the cache
+	 * Preconditions: crc (if not nullptr) must cover the bytes of out
+	 * Postconditions: the bytes are appended to out
+	 */
+	static void appendBytes(const uint8_t *data, size_t size,
+									vector<uint8_t> &out, RunningCrc32c *crc);
+
+	/**
+	 * decodeBlock
+	 * this function decodes one block, leaving its checksum to decode
+	 * Preconditions: size must be at least 1
+	 * Postconditions: returns the size of the block in bytes without
+	 * its checksum, or 0 on error, when out may hold part of the block
+	 */
+	static size_t decodeBlock(const uint8_t *data, size_t size,
+									  const DictionarySet &dictionaries,
+									  vector<uint8_t> &out);
+
+	/**
+	 * encodeRaw
+	 * Preconditions: crc (if not nullptr) must start at the end of out
+	 * Postconditions: a BLOCK_RAW block with data is appended to out,
+	 * marked as checked and folded into crc if crc is given
+	 */
+	static void encodeRaw(const uint8_t *data, size_t size, vector<uint8_t> &out,
+								 RunningCrc32c *crc);
+
+	/**
+	 * decodeMultiTable
+	 * this function decodes a BLOCK_MULTI_TABLE block, switching codebooks
+	 * at each segment boundary
+	 * Preconditions: data[0] must be BLOCK_MULTI_TABLE
+	 * Postconditions: returns the size of the block in bytes, or 0 if the
+	 * block is malformed
+	 * @param data: pointer to the start of the block
+	 * @param size: number of bytes available
+	 * @param out: vector the decoded bytes are appended to
+	 * @return: number of bytes in the block, 0 on error
+	 */
+	static size_t decodeMultiTable(const uint8_t *data, size_t size,
+											 vector<uint8_t> &out);
+
+	/**
+	 * decodeTransformed
+	 * this function decodes the inner block of a BLOCK_TRANSFORMED block
+	 * and runs the inverse of its pipeline
+	 * Preconditions: data[0] must be BLOCK_TRANSFORMED
+	 * Postconditions: returns the size of the block in bytes, or 0 if the
+	 * block is malformed
+	 * @param data: pointer to the start of the block
+	 * @param size: number of bytes available
+	 * @param out: vector the decoded bytes are appended to
+	 * @return: number of bytes in the block, 0 on error
+	 */
+	static size_t decodeTransformed(const uint8_t *data, size_t size,
+											  vector<uint8_t> &out);
+
+	/**
+	 * decodeAns
+	 * Preconditions: data[0] must be BLOCK_ANS
+	 * Postconditions: returns the size of the block in bytes, or 0 if the
+	 * block is malformed
+	 * @param data: pointer to the start of the block
+	 * @param size: number of bytes available
+	 * @param out: vector the decoded bytes are appended to
+	 * @return: number of bytes in the block, 0 on error
+	 */
+	static size_t decodeAns(const uint8_t *data, size_t size,
+									vector<uint8_t> &out);
+};
@@ -0,0 +1,164 @@
+/*
+ * @file BlockGenerator.cpp
+ * @author Katarina McGaughy
+ * BlockGenerator class: The BlockGenerator class compresses and
+ * decompresses a stream of BlockCodec blocks lazily with coroutines.
+ * The encoder pulls input from a source callback one block at a time
+ * and yields each encoded block when the caller asks for it, and the
+ * decoder pulls encoded bytes and yields each decoded block. Only one
+ * block is held at a time, so huge inputs never have to be in memory
+ * at once, and a caller can stop early or do its own work between
+ * blocks.
+ *
+ * Features:
+ * -Generator<EncodedBlock> and Generator<DecodedBlock> coroutines
+ * -the input buffer, output buffer and dictionary live in the coroutine
+ *  frame and are reused for every block
+ * -blocks with their own codebook or coded with a Dictionary, with or
+ *  without a CRC-32C
+ * -the decoder holds at most one largest block of encoded bytes and
+ *  decodes each block once
+ *
+ * Assumptions:
+ * -the source fills at most capacity bytes and returns how many it
+ *  wrote, 0 at the end of the input
+ * -a yielded block is only used until the Generator is advanced
+ * -a block is never larger than the BLOCK_RAW block of its bytes, so
+ *  once the decoder holds that many bytes for blockSize bytes of
+ *  input, a block that does not decode is malformed
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "BlockGenerator.h"
+#include <algorithm>
+#include "Varint.h"
+
+/**
+ * encode
+ * this function reads blockSize bytes at a time from source and
+ * yields each one as a BlockCodec block, coded with dictionary if
+ * one is given
+ * Preconditions: blockSize must be at least 1, every byte must have
+ * a code in dictionary
+ * Postconditions: yields one block per blockSize bytes of input,
+ * the last one shorter
+ * @param source: callback the input is read from
+ * @param blockSize: bytes of input in each block
+ * @param dictionary: dictionary to code with, or nullptr
+ * @param checksum: whether to add a CRC-32C to each block
+ * @return: Generator of the encoded blocks
+ */
+Generator<EncodedBlock> BlockGenerator::encode(BlockSource source,
+															  size_t blockSize,
+															  shared_ptr<const Dictionary> dictionary,
+															  bool checksum)
+{
+	vector<uint8_t> input(blockSize);
+	EncodedBlock block;
+	bool ended = false;
+	while (!ended)
+	{
+		// a source may return less than asked, so fill the whole block
+		// unless the input ends
+		size_t filled = 0;
+		while (filled < blockSize)
+		{
+			size_t read = source(input.data() + filled, blockSize - filled);
+			if (read == 0)
+			{
+				ended = true;
+				break;
+			}
+			filled += read;
+		}
+		if (filled == 0)
+		{
+			break;
+		}
+
+		block.rawSize = filled;
+		block.bytes.clear();
+		if (dictionary)
+		{
+			BlockCodec::encode(input.data(), filled, *dictionary, block.bytes,
+									 DEFAULT_MIN_SAVINGS, checksum);
+		}
+		else
+		{
+			BlockCodec::encode(input.data(), filled, block.bytes,
+									 DEFAULT_MIN_SAVINGS, CODER_AUTO, checksum);
+		}
+		co_yield block;
+	}
+}
+
+/**
+ * decode
+ * this function reads encoded bytes from source and yields the
+ * bytes of each block
+ * Preconditions: blockSize must be at least the blockSize the
+ * blocks were encoded with
+ * Postconditions: yields every block, then a block with failed set
+ * if the input ends in the middle of a block or holds bytes that
+ * are not a block
+ * @param source: callback the encoded bytes are read from
+ * @param dictionaries: dictionaries the blocks may refer to
+ * @param blockSize: bytes of input in each block
+ * @return: Generator of the decoded blocks
+ */
+Generator<DecodedBlock> BlockGenerator::decode(BlockSource source,
+															  DictionarySet dictionaries,
+															  size_t blockSize)
+{
+	// the largest block: a BLOCK_RAW block of blockSize bytes with its
+	// checksum
+	size_t maxBlock = 1 + varintSize(blockSize) + blockSize + 4;
+
+	// encoded bytes read but not yet decoded are input[start, end)
+	vector<uint8_t> input(maxBlock);
+	size_t start = 0;
+	size_t end = 0;
+	bool ended = false;
+	DecodedBlock block;
+	while (true)
+	{
+		// top the buffer up to a whole largest block, so the next block
+		// is complete unless the input ends first
+		if (!ended && end - start < maxBlock)
+		{
+			copy(input.begin() + start, input.begin() + end, input.begin());
+			end -= start;
+			start = 0;
+			while (end < maxBlock)
+			{
+				size_t read = source(input.data() + end, maxBlock - end);
+				if (read == 0)
+				{
+					ended = true;
+					break;
+				}
+				end += read;
+			}
+		}
+		if (start == end)
+		{
+			break;
+		}
+
+		block.bytes.clear();
+		size_t used = BlockCodec::decode(input.data() + start, end - start,
+													dictionaries, block.bytes);
+		if (used == 0)
+		{
+			block.failed = true;
+			co_yield block;
+			break;
+		}
+		start += used;
+		co_yield block;
+	}
+}
@@ -0,0 +1,118 @@
+/*
+ * @file BlockGenerator.h
+ * @author Katarina McGaughy
+ * BlockGenerator class: The BlockGenerator class compresses and
+ * decompresses a stream of BlockCodec blocks lazily with coroutines.
+ * The encoder pulls input from a source callback one block at a time
+ * and yields each encoded block when the caller asks for it, and the
+ * decoder pulls encoded bytes and yields each decoded block. Only one
+ * block is held at a time, so huge inputs never have to be in memory
+ * at once, and a caller can stop early or do its own work between
+ * blocks.
+ *
+ * Features:
+ * -Generator<EncodedBlock> and Generator<DecodedBlock> coroutines
+ * -the input buffer, output buffer and dictionary live in the coroutine
+ *  frame and are reused for every block
+ * -blocks with their own codebook or coded with a Dictionary, with or
+ *  without a CRC-32C
+ * -the decoder holds at most one largest block of encoded bytes and
+ *  decodes each block once
+ *
+ * Assumptions:
+ * -the source fills at most capacity bytes and returns how many it
+ *  wrote, 0 at the end of the input
+ * -a yielded block is only used until the Generator is advanced
+ * -a block is never larger than the BLOCK_RAW block of its bytes, so
+ *  once the decoder holds that many bytes for blockSize bytes of
+ *  input, a block that does not decode is malformed
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "BlockCodec.h"
+#include "Dictionary.h"
+#include "Generator.h"
+using namespace std;
+
+// bytes of input in each block the encoder writes
+const size_t DEFAULT_GENERATOR_BLOCK_SIZE = 1 << 16;
+
+// fills buffer with at most capacity bytes, returns the number written
+typedef function<size_t(uint8_t *buffer, size_t capacity)> BlockSource;
+
+/**
+ * EncodedBlock struct is one block yielded by the encoder
+ */
+struct EncodedBlock
+{
+	// bytes of input the block holds
+	size_t rawSize = 0;
+
+	// the BlockCodec block
+	vector<uint8_t> bytes;
+};
+
+/**
+ * DecodedBlock struct is one block yielded by the decoder
+ */
+struct DecodedBlock
+{
+	// true if the encoded bytes were not a valid block. This is the
+	// last value the decoder yields
+	bool failed = false;
+
+	vector<uint8_t> bytes;
+};
+
+class BlockGenerator
+{
+public:
+	/**
+	 * encode
+	 * this function reads blockSize bytes at a time from source and
+	 * yields each one as a BlockCodec block, coded with dictionary if
+	 * one is given
+	 * Preconditions: blockSize must be at least 1, every byte must have
+	 * a code in dictionary
+	 * Postconditions: yields one block per blockSize bytes of input,
+	 * the last one shorter
+	 * @param source: callback the input is read from
+	 * @param blockSize: bytes of input in each block
+	 * @param dictionary: dictionary to code with, or nullptr
+	 * @param checksum: whether to add a CRC-32C to each block
+	 * @return: Generator of the encoded blocks
+	 */
+	static Generator<EncodedBlock>
+	encode(BlockSource source, size_t blockSize = DEFAULT_GENERATOR_BLOCK_SIZE,
+			 shared_ptr<const Dictionary> dictionary = nullptr,
+			 bool checksum = false);
+
+	/**
+	 * decode
+	 * this function reads encoded bytes from source and yields the
+	 * bytes of each block
+	 * Preconditions: blockSize must be at least the blockSize the
+	 * blocks were encoded with
+	 * Postconditions: yields every block, then a block with failed set
+	 * if the input ends in the middle of a block or holds bytes that
+	 * are not a block
+	 * @param source: callback the encoded bytes are read from
+	 * @param dictionaries: dictionaries the blocks may refer to
+	 * @param blockSize: bytes of input in each block
+	 * @return: Generator of the decoded blocks
+	 */
+	static Generator<DecodedBlock>
+	decode(BlockSource source, DictionarySet dictionaries,
+			 size_t blockSize = DEFAULT_GENERATOR_BLOCK_SIZE);
+};
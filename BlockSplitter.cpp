@@ -0,0 +1,242 @@
+/*
+ * @file BlockSplitter.cpp
+ * @author Katarina McGaughy
+ * BlockSplitter class: The BlockSplitter class plans how to code a block
+ * whose statistics change part way through, such as logs that mix JSON,
+ * hex IDs and free text. The block is cut into chunks, the chunks are
+ * clustered into up to MAX_BLOCK_TABLES codebooks (the way bzip2 picks
+ * its tables), and neighbouring chunks that share a codebook are joined
+ * into segments. Each segment then carries the index of its codebook.
+ *
+ * Features:
+ * -histogram per chunk
+ * -iterative clustering: build each codebook from its chunks, then move
+ *  every chunk to the codebook that codes it in the fewest bits
+ * -try every table count up to maxTables and keep the cheapest,
+ *  headers included
+ *
+ * Assumptions:
+ * -codebooks are built with HuffmanAlgorithm::buildCodeLengths, so every
+ *  byte in a segment has a code in that segment's codebook
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "BlockSplitter.h"
+#include "CodebookHeader.h"
+#include "HuffmanAlgorithm.h"
+
+// rounds of rebuilding codebooks and moving chunks
+static const int CLUSTER_ITERATIONS = 4;
+
+// bits charged for a byte the codebook has no code for
+static const int UNCODED_COST = 20;
+
+// bits charged for each segment (length and codebook index)
+static const int SEGMENT_COST = 24;
+
+/**
+ * chunkCost
+ * Preconditions: histogram and lengths must have 256 entries
+ * Postconditions: returns the bits needed to code the histogram
+ */
+static uint64_t chunkCost(const vector<uint64_t> &histogram,
+								  const vector<int> &lengths)
+{
+	uint64_t bits = 0;
+	for (int s = 0; s < NUM_BYTE_SYMBOLS; s++)
+	{
+		if (histogram[s] > 0)
+		{
+			bits += histogram[s] *
+					  (lengths[s] > 0 ? lengths[s] : UNCODED_COST);
+		}
+	}
+	return bits;
+}
+
+/**
+ * Overloaded constructor
+ * this function finds the cheapest way to code data with 1 to
+ * maxTables codebooks
+ * Preconditions: maxTables must be between 1 and MAX_BLOCK_TABLES,
+ * chunkSize must be at least 1
+ * Postconditions: the codebooks and segments are planned
+ * @param data: pointer to the bytes of the block
+ * @param size: number of bytes
+ * @param maxTables: most codebooks to use
+ * @param chunkSize: bytes per chunk
+ */
+BlockSplitter::BlockSplitter(const uint8_t *data, size_t size, int maxTables,
+									  size_t chunkSize)
+{
+	// histogram of every chunk
+	size_t numChunks = (size + chunkSize - 1) / chunkSize;
+	vector<vector<uint64_t>> histograms(numChunks,
+												vector<uint64_t>(NUM_BYTE_SYMBOLS, 0));
+	for (size_t i = 0; i < size; i++)
+	{
+		histograms[i / chunkSize][data[i]]++;
+	}
+
+	// keep the cheapest number of codebooks
+	vector<int> assignment;
+	costBits_ = plan(histograms, 1, lengths_, assignment);
+	for (int numTables = 2; numTables <= maxTables; numTables++)
+	{
+		if ((size_t)numTables > numChunks)
+		{
+			break;
+		}
+		vector<vector<int>> lengths;
+		vector<int> tryAssignment;
+		uint64_t cost = plan(histograms, numTables, lengths, tryAssignment);
+		if (cost < costBits_)
+		{
+			costBits_ = cost;
+			lengths_ = lengths;
+			assignment = tryAssignment;
+		}
+	}
+
+	// join neighbouring chunks that share a codebook
+	for (size_t i = 0; i < numChunks; i++)
+	{
+		size_t length = i + 1 < numChunks ? chunkSize : size - i * chunkSize;
+		if (!segments_.empty() && segments_.back().table == assignment[i])
+		{
+			segments_.back().length += length;
+		}
+		else
+		{
+			Segment segment;
+			segment.length = length;
+			segment.table = assignment[i];
+			segments_.push_back(segment);
+		}
+	}
+}
+
+/**
+ * plan
+ * this function clusters the chunks into numTables codebooks
+ * Preconditions: histograms must hold one histogram per chunk
+ * Postconditions: returns the estimated cost in bits and fills
+ * lengths and assignment
+ */
+uint64_t BlockSplitter::plan(const vector<vector<uint64_t>> &histograms,
+									  int numTables, vector<vector<int>> &lengths,
+									  vector<int> &assignment) const
+{
+	size_t numChunks = histograms.size();
+
+	// start by cutting the block into numTables even parts
+	assignment.assign(numChunks, 0);
+	for (size_t i = 0; i < numChunks; i++)
+	{
+		assignment[i] = i * numTables / numChunks;
+	}
+
+	for (int iteration = 0; iteration < CLUSTER_ITERATIONS; iteration++)
+	{
+		// build each codebook from the chunks assigned to it
+		lengths.assign(numTables, vector<int>(NUM_BYTE_SYMBOLS, 0));
+		for (int t = 0; t < numTables; t++)
+		{
+			vector<uint64_t> counts(NUM_BYTE_SYMBOLS, 0);
+			for (size_t i = 0; i < numChunks; i++)
+			{
+				if (assignment[i] == t)
+				{
+					for (int s = 0; s < NUM_BYTE_SYMBOLS; s++)
+					{
+						counts[s] += histograms[i][s];
+					}
+				}
+			}
+			HuffmanAlgorithm::buildCodeLengths(counts.data(), NUM_BYTE_SYMBOLS,
+														  MAX_HEADER_CODE_LENGTH,
+														  lengths[t].data());
+		}
+		// the codebooks must match the final assignment
+		if (iteration == CLUSTER_ITERATIONS - 1)
+		{
+			break;
+		}
+
+		// move each chunk to its cheapest codebook
+		for (size_t i = 0; i < numChunks; i++)
+		{
+			uint64_t best = chunkCost(histograms[i], lengths[assignment[i]]);
+			for (int t = 0; t < numTables; t++)
+			{
+				uint64_t cost = chunkCost(histograms[i], lengths[t]);
+				if (cost < best)
+				{
+					best = cost;
+					assignment[i] = t;
+				}
+			}
+		}
+	}
+
+	// drop codebooks no chunk uses
+	vector<int> newIndex(numTables, -1);
+	vector<vector<int>> used;
+	for (size_t i = 0; i < numChunks; i++)
+	{
+		int t = assignment[i];
+		if (newIndex[t] < 0)
+		{
+			newIndex[t] = used.size();
+			used.push_back(lengths[t]);
+		}
+		assignment[i] = newIndex[t];
+	}
+	if (used.empty())
+	{
+		used.push_back(vector<int>(NUM_BYTE_SYMBOLS, 0));
+	}
+	lengths = used;
+
+	// codes, headers and segments
+	uint64_t cost = 0;
+	for (size_t i = 0; i < numChunks; i++)
+	{
+		cost += chunkCost(histograms[i], lengths[assignment[i]]);
+		if (i == 0 || assignment[i] != assignment[i - 1])
+		{
+			cost += SEGMENT_COST;
+		}
+	}
+	for (size_t t = 0; t < lengths.size(); t++)
+	{
+		vector<uint8_t> header;
+		CodebookHeader::write(lengths[t].data(), NUM_BYTE_SYMBOLS, header);
+		cost += header.size() * 8;
+	}
+	return cost;
+}
+
+int BlockSplitter::getNumTables() const
+{
+	return lengths_.size();
+}
+
+const int *BlockSplitter::getLengths(int table) const
+{
+	return lengths_[table].data();
+}
+
+const vector<BlockSplitter::Segment> &BlockSplitter::getSegments() const
+{
+	return segments_;
+}
+
+uint64_t BlockSplitter::getCostBits() const
+{
+	return costBits_;
+}
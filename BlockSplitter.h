@@ -0,0 +1,102 @@
+/*
+ * @file BlockSplitter.h
+ * @author Katarina McGaughy
+ * BlockSplitter class: The BlockSplitter class plans how to code a block
+ * whose statistics change part way through, such as logs that mix JSON,
+ * hex IDs and free text. The block is cut into chunks, the chunks are
+ * clustered into up to MAX_BLOCK_TABLES codebooks (the way bzip2 picks
+ * its tables), and neighbouring chunks that share a codebook are joined
+ * into segments. Each segment then carries the index of its codebook.
+ *
+ * Features:
+ * -histogram per chunk
+ * -iterative clustering: build each codebook from its chunks, then move
+ *  every chunk to the codebook that codes it in the fewest bits
+ * -try every table count up to maxTables and keep the cheapest,
+ *  headers included
+ *
+ * Assumptions:
+ * -codebooks are built with HuffmanAlgorithm::buildCodeLengths, so every
+ *  byte in a segment has a code in that segment's codebook
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Dictionary.h"
+using namespace std;
+
+// most codebooks a block may use
+const int MAX_BLOCK_TABLES = 8;
+
+// bytes per chunk when looking for segment boundaries
+const size_t DEFAULT_CHUNK_SIZE = 512;
+
+class BlockSplitter
+{
+public:
+	/**
+	 * Segment struct is a run of bytes coded with one codebook
+	 */
+	struct Segment
+	{
+		// number of bytes in the segment
+		size_t length = 0;
+
+		// index of the codebook
+		int table = 0;
+	};
+
+	/**
+	 * Overloaded constructor
+	 * this function finds the cheapest way to code data with 1 to
+	 * maxTables codebooks
+	 * Preconditions: maxTables must be between 1 and MAX_BLOCK_TABLES,
+	 * chunkSize must be at least 1
+	 * Postconditions: the codebooks and segments are planned
+	 * @param data: pointer to the bytes of the block
+	 * @param size: number of bytes
+	 * @param maxTables: most codebooks to use
+	 * @param chunkSize: bytes per chunk
+	 */
+	BlockSplitter(const uint8_t *data, size_t size,
+					  int maxTables = MAX_BLOCK_TABLES,
+					  size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+	/**
+	 * getNumTables, getLengths, getSegments, getCostBits
+	 * Preconditions: none
+	 * Postconditions: return the number of codebooks, the code lengths of
+	 * one codebook, the segments in order, and the estimated size of the
+	 * block in bits
+	 */
+	int getNumTables() const;
+	const int *getLengths(int table) const;
+	const vector<Segment> &getSegments() const;
+	uint64_t getCostBits() const;
+
+private:
+	/**
+	 * plan
+	 * this function clusters the chunks into numTables codebooks
+	 * Preconditions: histograms must hold one histogram per chunk
+	 * Postconditions: returns the estimated cost in bits and fills
+	 * lengths and assignment
+	 */
+	uint64_t plan(const vector<vector<uint64_t>> &histograms, int numTables,
+					  vector<vector<int>> &lengths, vector<int> &assignment) const;
+
+	// code lengths of each codebook
+	vector<vector<int>> lengths_;
+
+	vector<Segment> segments_;
+
+	uint64_t costBits_ = 0;
+};
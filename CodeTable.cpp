@@ -0,0 +1,324 @@
+/*
+ * @file CodeTable.cpp
+ * @author Katarina McGaughy
+ * CodeTable class: The CodeTable class holds the encode and decode
+ * tables for one codebook. It is never modified after construction, so
+ * a single CodeTable can be shared by reference-counted pointer between
+ * any number of threads that encode or decode at the same time.
+ *
+ * Features:
+ * -encode table (code for each symbol)
+ * -decode table (flattened binary trie of the codes)
+ * -LookupDecoder with a primary table and subtables, so decodeSymbol
+ *  reads a whole code with one or two lookups
+ * -encode and decode strings of symbols
+ *
+ * Assumptions:
+ * -symbols are the characters firstSymbol, firstSymbol + 1, ... in order,
+ *  so letters use 'a' and bytes use 0
+ * -codes are strings of 0s and 1s that form a prefix code
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "CodeTable.h"
+#include <cstdint>
+
+/**
+ * Overloaded constructor
+ * this function copies the code for each symbol into the encode
+ * table, inserts every code into the decode table and builds the
+ * lookup tables
+ * Preconditions: codeBook must hold numSymbols codes that form a
+ * prefix code
+ * Postconditions: CodeTable is ready to encode and decode
+ * @param codeBook: string array of codes, one per symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param firstSymbol: character of symbol 0
+ */
+CodeTable::CodeTable(const string codeBook[], int numSymbols, char firstSymbol)
+	: firstSymbol_(firstSymbol), codes_(codeBook, codeBook + numSymbols),
+	  bits_(numSymbols, 0), lengths_(numSymbols, 0), decodeTable_(1)
+{
+	for (int i = 0; i < numSymbols; i++)
+	{
+		const string &code = codes_[i];
+		int node = 0;
+		int length = code.length();
+		lengths_[i] = length;
+		for (int j = 0; j < length; j++)
+		{
+			int bit = code[j] - '0';
+			bits_[i] = (bits_[i] << 1) | bit;
+			// last bit of the code points at the symbol
+			if (j == length - 1)
+			{
+				decodeTable_[node].child[bit] = -(i + 1);
+			}
+			else
+			{
+				// add a new entry the first time this prefix is seen
+				if (decodeTable_[node].child[bit] <= 0)
+				{
+					decodeTable_[node].child[bit] = decodeTable_.size();
+					decodeTable_.push_back(DecodeNode());
+				}
+				node = decodeTable_[node].child[bit];
+			}
+		}
+	}
+	lookup_ = LookupDecoder(bits_.data(), lengths_.data(), numSymbols);
+}
+
+/**
+ * fromLengths
+ * this function assigns canonical codes to the code lengths: codes
+ * are handed out in order of length, then symbol, so the lengths
+ * alone are enough to rebuild the same CodeTable
+ * Preconditions: lengths must form a prefix code, 0 marks a symbol
+ * without a code
+ * Postconditions: returns the CodeTable for the canonical codes
+ * @param lengths: integer array of code lengths, one per symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param firstSymbol: character of symbol 0
+ * @return: shared pointer to the new CodeTable
+ */
+shared_ptr<const CodeTable> CodeTable::fromLengths(const int lengths[],
+																	int numSymbols,
+																	char firstSymbol)
+{
+	// count codes of each length
+	int maxLength = 0;
+	for (int i = 0; i < numSymbols; i++)
+	{
+		if (lengths[i] > maxLength)
+		{
+			maxLength = lengths[i];
+		}
+	}
+	vector<uint64_t> lengthCount(maxLength + 1, 0);
+	for (int i = 0; i < numSymbols; i++)
+	{
+		lengthCount[lengths[i]]++;
+	}
+	lengthCount[0] = 0;
+
+	// first code of each length
+	vector<uint64_t> nextCode(maxLength + 1, 0);
+	uint64_t code = 0;
+	for (int len = 1; len <= maxLength; len++)
+	{
+		code = (code + lengthCount[len - 1]) << 1;
+		nextCode[len] = code;
+	}
+
+	vector<string> codeBook(numSymbols);
+	for (int i = 0; i < numSymbols; i++)
+	{
+		int len = lengths[i];
+		if (len > 0)
+		{
+			uint64_t bits = nextCode[len]++;
+			string &text = codeBook[i];
+			text.resize(len);
+			for (int j = 0; j < len; j++)
+			{
+				text[j] = '0' + ((bits >> (len - 1 - j)) & 1);
+			}
+		}
+	}
+	return make_shared<const CodeTable>(codeBook.data(), numSymbols,
+													firstSymbol);
+}
+
+/**
+ * size
+ * Preconditions: none
+ * Postconditions: returns the number of symbols in the alphabet
+ * @return: number of symbols
+ */
+int CodeTable::size() const
+{
+	return codes_.size();
+}
+
+/**
+ * getCode
+ * Preconditions: symbol must be between 0 and size() - 1
+ * Postconditions: returns the code for symbol
+ * @param symbol: index of the symbol
+ * @return: code for the symbol
+ */
+const string &CodeTable::getCode(int symbol) const
+{
+	return codes_[symbol];
+}
+
+/**
+ * getLength
+ * Preconditions: symbol must be between 0 and size() - 1
+ * Postconditions: returns the length of the code for symbol, 0 if
+ * the symbol has no code
+ * @param symbol: index of the symbol
+ * @return: length of the code
+ */
+int CodeTable::getLength(int symbol) const
+{
+	return lengths_[symbol];
+}
+
+/**
+ * symbolOf
+ * Preconditions: none
+ * Postconditions: returns the symbol for c or -1 if c is not in
+ * the alphabet
+ * @param c: character to look up
+ * @return: index of the symbol or -1
+ */
+int CodeTable::symbolOf(char c) const
+{
+	int symbol = (unsigned char)c - (unsigned char)firstSymbol_;
+	if (symbol < 0 || symbol >= size())
+	{
+		return -1;
+	}
+	return symbol;
+}
+
+/**
+ * getWord
+ * this funtion takes in a string and then returns the
+ * code for that string, skipping characters outside the alphabet
+ * Preconditions: none
+ * PostConditions: returns the code for the string entered
+ * @param in: string to encode
+ * @return: the code for the string entered
+ */
+string CodeTable::getWord(const string &in) const
+{
+	string code = "";
+	int length = in.length();
+	for (int i = 0; i < length; i++)
+	{
+		int symbol = symbolOf(in[i]);
+		if (symbol >= 0)
+		{
+			code += codes_[symbol];
+		}
+	}
+	return code;
+}
+
+/**
+ * decode
+ * this function takes in a string of 0s and 1s produced by getWord
+ * and walks the decode table to recover the characters
+ * Preconditions: none
+ * PostConditions: returns the characters for the code entered,
+ * stopping at the last complete code
+ * @param bits: string of 0s and 1s
+ * @return: the decoded characters
+ */
+string CodeTable::decode(const string &bits) const
+{
+	string word = "";
+	int node = 0;
+	int length = bits.length();
+	for (int i = 0; i < length; i++)
+	{
+		int next = decodeTable_[node].child[bits[i] - '0'];
+		if (next < 0)
+		{
+			word += (char)(firstSymbol_ + (-next - 1));
+			node = 0;
+		}
+		else
+		{
+			node = next;
+		}
+	}
+	return word;
+}
+
+/**
+ * decodeSymbol
+ * this function reads one code from in with the LookupDecoder, or by
+ * walking the decode table if a code is too long for it
+ * Preconditions: none
+ * Postconditions: returns the symbol read, or -1 if the data ends
+ * before the code is complete
+ * @param in: BitReader positioned at the start of a code
+ * @return: index of the symbol or -1
+ */
+int CodeTable::decodeSymbol(BitReader &in) const
+{
+	if (lookup_.isValid())
+	{
+		return lookup_.decodeSymbol(in);
+	}
+	int node = 0;
+	while (true)
+	{
+		int bit = in.readBit();
+		if (bit < 0)
+		{
+			return -1;
+		}
+		node = decodeTable_[node].child[bit];
+		if (node < 0)
+		{
+			return -node - 1;
+		}
+		// 0 means no code continues with this bit
+		if (node == 0)
+		{
+			return -1;
+		}
+	}
+}
+
+/**
+ * encode
+ * this function writes the code for each byte, where the byte value
+ * is the symbol index
+ * Preconditions: every byte must be a symbol with a code
+ * Postconditions: the codes are written to out
+ * @param data: pointer to the bytes
+ * @param size: number of bytes
+ * @param out: BitWriter the codes are written to
+ */
+void CodeTable::encode(const uint8_t *data, size_t size, BitWriter &out) const
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		encodeSymbol(data[i], out);
+	}
+}
+
+/**
+ * decode
+ * this function reads count symbols from in and appends them to out
+ * as bytes
+ * Preconditions: symbols must fit in a byte
+ * Postconditions: returns false if the data ends early
+ * @param in: BitReader positioned at the first code
+ * @param count: number of symbols to read
+ * @param out: vector the bytes are appended to
+ * @return: true if count symbols were read
+ */
+bool CodeTable::decode(BitReader &in, size_t count, vector<uint8_t> &out) const
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		int symbol = decodeSymbol(in);
+		if (symbol < 0)
+		{
+			return false;
+		}
+		out.push_back((uint8_t)symbol);
+	}
+	return true;
+}
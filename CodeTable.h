@@ -0,0 +1,240 @@
+/*
+ * @file CodeTable.h
+ * @author Katarina McGaughy
+ * CodeTable class: The CodeTable class holds the encode and decode
+ * tables for one codebook. It is never modified after construction, so
+ * a single CodeTable can be shared by reference-counted pointer between
+ * any number of threads that encode or decode at the same time.
+ *
+ * Features:
+ * -encode table (code for each symbol)
+ * -decode table (flattened binary trie of the codes)
+ * -LookupDecoder with a primary table and subtables, so decodeSymbol
+ *  reads a whole code with one or two lookups
+ * -encode and decode strings of symbols
+ * -encode and decode packed bits through BitWriter and BitReader
+ *
+ * Assumptions:
+ * -symbols are the characters firstSymbol, firstSymbol + 1, ... in order,
+ *  so letters use 'a' and bytes use 0
+ * -codes are strings of 0s and 1s that form a prefix code
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BitStream.h"
+#include "LookupDecoder.h"
+using namespace std;
+
+class CodeTable
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * this function copies the code for each symbol into the encode
+	 * table, inserts every code into the decode table and builds the
+	 * lookup tables
+	 * Preconditions: codeBook must hold numSymbols codes that form a
+	 * prefix code
+	 * Postconditions: CodeTable is ready to encode and decode
+	 * @param codeBook: string array of codes, one per symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param firstSymbol: character of symbol 0
+	 */
+	CodeTable(const string codeBook[], int numSymbols, char firstSymbol = 'a');
+
+	/**
+	 * fromLengths
+	 * this function assigns canonical codes to the code lengths: codes
+	 * are handed out in order of length, then symbol, so the lengths
+	 * alone are enough to rebuild the same CodeTable
+	 * Preconditions: lengths must form a prefix code, 0 marks a symbol
+	 * without a code
+	 * Postconditions: returns the CodeTable for the canonical codes
+	 * @param lengths: integer array of code lengths, one per symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param firstSymbol: character of symbol 0
+	 * @return: shared pointer to the new CodeTable
+	 */
+	static shared_ptr<const CodeTable> fromLengths(const int lengths[],
+																  int numSymbols,
+																  char firstSymbol = 'a');
+
+	/**
+	 * size
+	 * Preconditions: none
+	 * Postconditions: returns the number of symbols in the alphabet
+	 * @return: number of symbols
+	 */
+	int size() const;
+
+	/**
+	 * getCode
+	 * Preconditions: symbol must be between 0 and size() - 1
+	 * Postconditions: returns the code for symbol
+	 * @param symbol: index of the symbol
+	 * @return: code for the symbol
+	 */
+	const string &getCode(int symbol) const;
+
+	/**
+	 * getLength
+	 * Preconditions: symbol must be between 0 and size() - 1
+	 * Postconditions: returns the length of the code for symbol, 0 if
+	 * the symbol has no code
+	 * @param symbol: index of the symbol
+	 * @return: length of the code
+	 */
+	int getLength(int symbol) const;
+
+	/**
+	 * getBits
+	 * Preconditions: symbol must be between 0 and size() - 1
+	 * Postconditions: returns the code for symbol as right aligned
+	 * bits, getLength(symbol) of them
+	 * @param symbol: index of the symbol
+	 * @return: bits of the code
+	 */
+	uint64_t getBits(int symbol) const
+	{
+		return bits_[symbol];
+	}
+
+	/**
+	 * getWord
+	 * this funtion takes in a string and then returns the
+	 * code for that string, skipping characters outside the alphabet
+	 * Preconditions: none
+	 * PostConditions: returns the code for the string entered
+	 * @param in: string to encode
+	 * @return: the code for the string entered
+	 */
+	string getWord(const string &in) const;
+
+	/**
+	 * decode
+	 * this function takes in a string of 0s and 1s produced by getWord
+	 * and walks the decode table to recover the characters
+	 * Preconditions: none
+	 * PostConditions: returns the characters for the code entered,
+	 * stopping at the last complete code
+	 * @param bits: string of 0s and 1s
+	 * @return: the decoded characters
+	 */
+	string decode(const string &bits) const;
+
+	/**
+	 * encodeSymbol
+	 * Preconditions: symbol must have a code of at most
+	 * MAX_BITS_PER_CALL bits
+	 * Postconditions: the code for symbol is written to out
+	 * @param symbol: index of the symbol
+	 * @param out: BitWriter the code is written to
+	 */
+	void encodeSymbol(int symbol, BitWriter &out) const
+	{
+		out.write(bits_[symbol], lengths_[symbol]);
+	}
+
+	/**
+	 * decodeSymbol
+	 * this function reads one code from in with the LookupDecoder, or by
+	 * walking the decode table if a code is too long for it
+	 * Preconditions: none
+	 * Postconditions: returns the symbol read, or -1 if the data ends
+	 * before the code is complete
+	 * @param in: BitReader positioned at the start of a code
+	 * @return: index of the symbol or -1
+	 */
+	int decodeSymbol(BitReader &in) const;
+
+	/**
+	 * decodeStep
+	 * this function follows one bit through the decode table, so a
+	 * code can be decoded a bit at a time across separate buffers
+	 * Preconditions: node must be 0 or a positive value returned by
+	 * decodeStep
+	 * Postconditions: returns the next node, -(symbol + 1) once the bit
+	 * completes a code, or 0 if no code continues with this bit
+	 * @param node: current node, 0 at the start of a code
+	 * @param bit: 0 or 1
+	 * @return: next node, -(symbol + 1) or 0
+	 */
+	int decodeStep(int node, int bit) const
+	{
+		return decodeTable_[node].child[bit];
+	}
+
+	/**
+	 * encode
+	 * this function writes the code for each byte, where the byte value
+	 * is the symbol index
+	 * Preconditions: every byte must be a symbol with a code
+	 * Postconditions: the codes are written to out
+	 * @param data: pointer to the bytes
+	 * @param size: number of bytes
+	 * @param out: BitWriter the codes are written to
+	 */
+	void encode(const uint8_t *data, size_t size, BitWriter &out) const;
+
+	/**
+	 * decode
+	 * this function reads count symbols from in and appends them to out
+	 * as bytes
+	 * Preconditions: symbols must fit in a byte
+	 * Postconditions: returns false if the data ends early
+	 * @param in: BitReader positioned at the first code
+	 * @param count: number of symbols to read
+	 * @param out: vector the bytes are appended to
+	 * @return: true if count symbols were read
+	 */
+	bool decode(BitReader &in, size_t count, vector<uint8_t> &out) const;
+
+private:
+	/**
+	 * DecodeNode struct is one entry of the decode table, a flattened
+	 * binary trie of the codes. child[0] and child[1] hold the index
+	 * of the next entry for a 0 or 1 bit, or -(symbol + 1) when the bit
+	 * completes the code for a symbol
+	 */
+	struct DecodeNode
+	{
+		int child[2] = {0, 0};
+	};
+
+	// character of symbol 0
+	char firstSymbol_;
+
+	// code for each symbol
+	vector<string> codes_;
+
+	// code for each symbol as right aligned bits, and its length
+	vector<uint64_t> bits_;
+	vector<int> lengths_;
+
+	// decode table built from codes_, entry 0 is the root
+	vector<DecodeNode> decodeTable_;
+
+	// lookup tables built from bits_ and lengths_
+	LookupDecoder lookup_;
+
+	/**
+	 * symbolOf
+	 * Preconditions: none
+	 * Postconditions: returns the symbol for c or -1 if c is not in
+	 * the alphabet
+	 * @param c: character to look up
+	 * @return: index of the symbol or -1
+	 */
+	int symbolOf(char c) const;
+};
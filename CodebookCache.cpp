@@ -0,0 +1,154 @@
+/*
+ * @file CodebookCache.cpp
+ * @author Katarina McGaughy
+ * CodebookCache class: The CodebookCache class keeps the most recently
+ * used CodeTables keyed by a quantized copy of the
+ * frequency table they were built from. Frequency tables that are the
+ * same or nearly the same share one codebook, so a hit costs one hash
+ * and one lookup instead of a HuffmanTree build.
+ *
+ * Features:
+ * -quantize a frequency table into a cache key
+ * -least recently used eviction once capacity is reached
+ * -safe to call from several threads at once
+ * -hit and miss counters
+ *
+ * Assumptions:
+ * -cached codebooks are never modified once built
+ * -codebooks are built from the quantized counts, so every table that
+ *  maps to the same key gets the same codebook
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "CodebookCache.h"
+
+/**
+ * constructor
+ * this function initializes an empty cache holding at most
+ * capacity codebooks
+ * Preconditions: capacity must be at least 1
+ * Postconditions: empty cache with zeroed counters
+ * @param capacity: maximum number of codebooks kept
+ */
+CodebookCache::CodebookCache(size_t capacity)
+	: capacity_(capacity < 1 ? 1 : capacity)
+{
+}
+
+/**
+ * get
+ * this function returns the codebook for counts, building canonical
+ * codes from HuffmanAlgorithm::buildCodeLengths only if no codebook
+ * for the quantized counts is cached. The codebook becomes the most
+ * recently used entry
+ * Preconditions: counts must have length 26
+ * Postconditions: returns a shared, immutable CodeTable
+ * @param counts: 64 bit frequencies for each lowercase letter
+ * @return: codebook for the quantized counts
+ */
+shared_ptr<const CodeTable> CodebookCache::get(
+	const uint64_t (&counts)[NUM_LETTERS])
+{
+	Key key = quantize(counts);
+	{
+		lock_guard<mutex> guard(lock_);
+		auto found = index_.find(key);
+		if (found != index_.end())
+		{
+			// move entry to the front of the list
+			lru_.splice(lru_.begin(), lru_, found->second);
+			hits_++;
+			return found->second->second;
+		}
+	}
+	misses_++;
+
+	// build outside the lock so other threads can keep hitting. Every
+	// letter keeps a code, as it does in a HuffmanAlgorithm CodeBook, and
+	// NUM_LETTERS - 1 bits is as long as a code for 26 letters can be,
+	// so the lengths are not limited
+	uint64_t weights[NUM_LETTERS];
+	for (int i = 0; i < NUM_LETTERS; i++)
+	{
+		weights[i] = key[i] > 0 ? key[i] : 1;
+	}
+	int lengths[NUM_LETTERS];
+	HuffmanAlgorithm::buildCodeLengths(weights, NUM_LETTERS, NUM_LETTERS - 1,
+												  lengths);
+	shared_ptr<const CodeTable> built =
+		 CodeTable::fromLengths(lengths, NUM_LETTERS);
+
+	lock_guard<mutex> guard(lock_);
+	// another thread may have built the same codebook meanwhile
+	auto found = index_.find(key);
+	if (found != index_.end())
+	{
+		lru_.splice(lru_.begin(), lru_, found->second);
+		return found->second->second;
+	}
+	lru_.push_front(Entry(key, built));
+	index_[key] = lru_.begin();
+	if (lru_.size() > capacity_)
+	{
+		index_.erase(lru_.back().first);
+		lru_.pop_back();
+	}
+	return built;
+}
+
+/**
+ * quantize
+ * this function scales counts so they total CACHE_QUANT_TOTAL,
+ * keeping every nonzero count at 1 or more (see
+ * HuffmanAlgorithm::normalizeCounts)
+ * Preconditions: none
+ * Postconditions: returns the key for counts
+ * @param counts: 64 bit frequencies for each lowercase letter
+ * @return: quantized counts
+ */
+CodebookCache::Key CodebookCache::quantize(const uint64_t (&counts)[NUM_LETTERS])
+{
+	Key key = {};
+	HuffmanAlgorithm::normalizeCounts(counts, NUM_LETTERS, CACHE_QUANT_TOTAL,
+												 key.data());
+	return key;
+}
+
+/**
+ * KeyHash
+ * this function hashes the quantized counts with FNV-1a
+ * Preconditions: none
+ * Postconditions: returns the hash of key
+ * @param key: quantized counts
+ * @return: hash of key
+ */
+size_t CodebookCache::KeyHash::operator()(const Key &key) const
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for (int i = 0; i < NUM_LETTERS; i++)
+	{
+		hash ^= (uint64_t)key[i];
+		hash *= 1099511628211ULL;
+	}
+	return (size_t)hash;
+}
+
+uint64_t CodebookCache::getHits() const
+{
+	return hits_.load();
+}
+
+uint64_t CodebookCache::getMisses() const
+{
+	return misses_.load();
+}
+
+size_t CodebookCache::size() const
+{
+	lock_guard<mutex> guard(lock_);
+	return lru_.size();
+}
@@ -0,0 +1,118 @@
+/*
+ * @file CodebookCache.h
+ * @author Katarina McGaughy
+ * CodebookCache class: The CodebookCache class keeps the most recently
+ * used CodeTables keyed by a quantized copy of the
+ * frequency table they were built from. Frequency tables that are the
+ * same or nearly the same share one codebook, so a hit costs one hash
+ * and one lookup instead of a HuffmanTree build.
+ *
+ * Features:
+ * -quantize a frequency table into a cache key
+ * -least recently used eviction once capacity is reached
+ * -safe to call from several threads at once
+ * -hit and miss counters
+ *
+ * Assumptions:
+ * -cached codebooks are never modified once built
+ * -codebooks are built from the quantized counts, so every table that
+ *  maps to the same key gets the same codebook
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "HuffmanAlgorithm.h"
+using namespace std;
+
+// total the counts are scaled to before they are used as a key
+const uint64_t CACHE_QUANT_TOTAL = 4096;
+
+class CodebookCache
+{
+public:
+	// quantized frequency table used as the key
+	typedef array<uint64_t, NUM_LETTERS> Key;
+
+	/**
+	 * constructor
+	 * this function initializes an empty cache holding at most
+	 * capacity codebooks
+	 * Preconditions: capacity must be at least 1
+	 * Postconditions: empty cache with zeroed counters
+	 * @param capacity: maximum number of codebooks kept
+	 */
+	explicit CodebookCache(size_t capacity);
+
+	/**
+	 * get
+	 * this function returns the codebook for counts, building canonical
+	 * codes from HuffmanAlgorithm::buildCodeLengths only if no codebook
+	 * for the quantized counts is cached. The codebook becomes the most
+	 * recently used entry
+	 * Preconditions: counts must have length 26
+	 * Postconditions: returns a shared, immutable CodeTable
+	 * @param counts: 64 bit frequencies for each lowercase letter
+	 * @return: codebook for the quantized counts
+	 */
+	shared_ptr<const CodeTable> get(const uint64_t (&counts)[NUM_LETTERS]);
+
+	/**
+	 * quantize
+	 * this function scales counts so they total CACHE_QUANT_TOTAL,
+	 * keeping every nonzero count at 1 or more (see
+	 * HuffmanAlgorithm::normalizeCounts)
+	 * Preconditions: none
+	 * Postconditions: returns the key for counts
+	 * @param counts: 64 bit frequencies for each lowercase letter
+	 * @return: quantized counts
+	 */
+	static Key quantize(const uint64_t (&counts)[NUM_LETTERS]);
+
+	/**
+	 * getHits, getMisses, size
+	 * Preconditions: none
+	 * Postconditions: return the number of hits, number of misses, and
+	 * number of codebooks currently cached
+	 */
+	uint64_t getHits() const;
+	uint64_t getMisses() const;
+	size_t size() const;
+
+private:
+	/**
+	 * KeyHash struct hashes a Key with FNV-1a
+	 */
+	struct KeyHash
+	{
+		size_t operator()(const Key &key) const;
+	};
+
+	typedef pair<Key, shared_ptr<const CodeTable>> Entry;
+
+	// maximum number of codebooks kept
+	size_t capacity_;
+
+	// entries ordered from most to least recently used
+	list<Entry> lru_;
+
+	// key to position in lru_
+	unordered_map<Key, list<Entry>::iterator, KeyHash> index_;
+
+	// guards lru_ and index_
+	mutable mutex lock_;
+
+	atomic<uint64_t> hits_{0};
+	atomic<uint64_t> misses_{0};
+};
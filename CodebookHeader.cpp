@@ -0,0 +1,173 @@
+/*
+ * @file CodebookHeader.cpp
+ * @author Katarina McGaughy
+ * CodebookHeader class: The CodebookHeader class writes and reads the
+ * compact header that stores a codebook. Only the canonical code lengths
+ * are stored, so CodeTable::fromLengths rebuilds the exact same codes.
+ *
+ * Features:
+ * -write code lengths taken from a HuffmanTree or from counts
+ * -read code lengths into a caller supplied array without allocating
+ *
+ * Format:
+ * -number of symbols as a varint (7 bits per byte, low bits first)
+ * -one 4 bit length per symbol, high nibble first. After two equal
+ *  lengths in a row, the next nibble is how many more times that
+ *  length repeats (0 to 15). The last byte is padded with a 0 nibble
+ *
+ * Assumptions:
+ * -code lengths are at most MAX_HEADER_CODE_LENGTH
+ * -a length of 0 means the symbol has no code
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "CodebookHeader.h"
+#include "HuffmanAlgorithm.h"
+#include "Varint.h"
+
+/**
+ * write
+ * this function appends the header for the code lengths to out
+ * Preconditions: every length must be between 0 and
+ * MAX_HEADER_CODE_LENGTH
+ * Postconditions: header bytes are appended to out
+ * @param lengths: integer array of code lengths, one per symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param out: vector the header is appended to
+ */
+void CodebookHeader::write(const int lengths[], int numSymbols,
+									vector<uint8_t> &out)
+{
+	// number of symbols
+	writeVarint(numSymbols, out);
+
+	// nibbles, packed two to a byte once the header is complete
+	vector<uint8_t> nibbles;
+	int i = 0;
+	while (i < numSymbols)
+	{
+		int run = 1;
+		while (i + run < numSymbols && run < 17 &&
+				 lengths[i + run] == lengths[i])
+		{
+			run++;
+		}
+		nibbles.push_back(lengths[i]);
+		if (run >= 2)
+		{
+			// a pair is always followed by its repeat count
+			nibbles.push_back(lengths[i]);
+			nibbles.push_back(run - 2);
+		}
+		i += run;
+	}
+	for (size_t j = 0; j < nibbles.size(); j += 2)
+	{
+		uint8_t low = j + 1 < nibbles.size() ? nibbles[j + 1] : 0;
+		out.push_back((nibbles[j] << 4) | low);
+	}
+}
+
+/**
+ * read
+ * this function reads a header into lengths without allocating
+ * Preconditions: lengths must have room for maxSymbols entries
+ * Postconditions: returns the number of header bytes read, or 0 if
+ * the header is malformed, has more than maxSymbols symbols, or its
+ * lengths do not form a prefix code
+ * @param data: pointer to the first header byte
+ * @param size: number of bytes available
+ * @param lengths: integer array the code lengths are stored in
+ * @param maxSymbols: room in lengths
+ * @param numSymbols: set to the number of symbols read
+ * @return: number of bytes read, 0 on error
+ */
+size_t CodebookHeader::read(const uint8_t *data, size_t size, int lengths[],
+									 int maxSymbols, int &numSymbols)
+{
+	// number of symbols
+	uint64_t value = 0;
+	size_t pos = readVarint(data, size, value);
+	if (pos == 0 || value > (uint64_t)maxSymbols)
+	{
+		return 0;
+	}
+	numSymbols = value;
+
+	// nibbles
+	size_t nibble = pos * 2;
+	const size_t endNibble = size * 2;
+	int count = 0;
+	int previous = -1;
+	while (count < numSymbols)
+	{
+		if (nibble >= endNibble)
+		{
+			return 0;
+		}
+		int length = (data[nibble / 2] >> (nibble % 2 == 0 ? 4 : 0)) & 0xF;
+		nibble++;
+		lengths[count++] = length;
+		if (length == previous)
+		{
+			if (nibble >= endNibble)
+			{
+				return 0;
+			}
+			int repeat = (data[nibble / 2] >> (nibble % 2 == 0 ? 4 : 0)) & 0xF;
+			nibble++;
+			if (count + repeat > numSymbols)
+			{
+				return 0;
+			}
+			for (int j = 0; j < repeat; j++)
+			{
+				lengths[count++] = length;
+			}
+			previous = -1;
+		}
+		else
+		{
+			previous = length;
+		}
+	}
+
+	// reject lengths that are not a prefix code
+	const uint32_t one = 1 << MAX_HEADER_CODE_LENGTH;
+	uint32_t kraft = 0;
+	for (int i = 0; i < numSymbols; i++)
+	{
+		if (lengths[i] > 0)
+		{
+			kraft += one >> lengths[i];
+			if (kraft > one)
+			{
+				return 0;
+			}
+		}
+	}
+	return (nibble + 1) / 2;
+}
+
+/**
+ * fromCounts
+ * this function builds limited code lengths from counts through
+ * HuffmanAlgorithm::buildCodeLengths and appends their header to out
+ * Preconditions: counts and lengths must have numSymbols entries
+ * Postconditions: lengths holds the code lengths written to out
+ * @param counts: 64 bit frequencies for each symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param lengths: integer array of code lengths
+ * @param out: vector the header is appended to
+ */
+void CodebookHeader::fromCounts(const uint64_t counts[], int numSymbols,
+										  int lengths[], vector<uint8_t> &out)
+{
+	HuffmanAlgorithm::buildCodeLengths(counts, numSymbols,
+												  MAX_HEADER_CODE_LENGTH, lengths);
+	write(lengths, numSymbols, out);
+}
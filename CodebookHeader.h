@@ -0,0 +1,83 @@
+/*
+ * @file CodebookHeader.h
+ * @author Katarina McGaughy
+ * CodebookHeader class: The CodebookHeader class writes and reads the
+ * compact header that stores a codebook. Only the canonical code lengths
+ * are stored, so CodeTable::fromLengths rebuilds the exact same codes.
+ *
+ * Features:
+ * -write code lengths taken from a HuffmanTree or from counts
+ * -read code lengths into a caller supplied array without allocating
+ *
+ * Format:
+ * -number of symbols as a varint (7 bits per byte, low bits first)
+ * -one 4 bit length per symbol, high nibble first. After two equal
+ *  lengths in a row, the next nibble is how many more times that
+ *  length repeats (0 to 15). The last byte is padded with a 0 nibble
+ *
+ * Assumptions:
+ * -code lengths are at most MAX_HEADER_CODE_LENGTH
+ * -a length of 0 means the symbol has no code
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// longest code length a header can store
+const int MAX_HEADER_CODE_LENGTH = 15;
+
+class CodebookHeader
+{
+public:
+	/**
+	 * write
+	 * this function appends the header for the code lengths to out
+	 * Preconditions: every length must be between 0 and
+	 * MAX_HEADER_CODE_LENGTH
+	 * Postconditions: header bytes are appended to out
+	 * @param lengths: integer array of code lengths, one per symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param out: vector the header is appended to
+	 */
+	static void write(const int lengths[], int numSymbols, vector<uint8_t> &out);
+
+	/**
+	 * read
+	 * this function reads a header into lengths without allocating
+	 * Preconditions: lengths must have room for maxSymbols entries
+	 * Postconditions: returns the number of header bytes read, or 0 if
+	 * the header is malformed, has more than maxSymbols symbols, or its
+	 * lengths do not form a prefix code
+	 * @param data: pointer to the first header byte
+	 * @param size: number of bytes available
+	 * @param lengths: integer array the code lengths are stored in
+	 * @param maxSymbols: room in lengths
+	 * @param numSymbols: set to the number of symbols read
+	 * @return: number of bytes read, 0 on error
+	 */
+	static size_t read(const uint8_t *data, size_t size, int lengths[],
+							 int maxSymbols, int &numSymbols);
+
+	/**
+	 * fromCounts
+	 * this function builds limited code lengths from counts through
+	 * HuffmanAlgorithm::buildCodeLengths and appends their header to out
+	 * Preconditions: counts and lengths must have numSymbols entries
+	 * Postconditions: lengths holds the code lengths written to out
+	 * @param counts: 64 bit frequencies for each symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param lengths: integer array of code lengths
+	 * @param out: vector the header is appended to
+	 */
+	static void fromCounts(const uint64_t counts[], int numSymbols,
+								  int lengths[], vector<uint8_t> &out);
+};
@@ -0,0 +1,186 @@
+/*
+ * @file CompressedSearch.cpp
+ * @author Katarina McGaughy
+ * CompressedSearch class: The CompressedSearch class finds a pattern in
+ * a packed code stream without decompressing it. The pattern is encoded
+ * with the same CodeTable, the way getWord encodes a string, and its
+ * bits are compared against the stream at every bit position. A bit
+ * match is only a real match when it starts on a code boundary, so each
+ * candidate is checked by decoding forward from the last known boundary,
+ * or from the nearest SeekIndex checkpoint when an index is given.
+ * Without an index the check decodes every symbol up to the last
+ * candidate, so the saving over a full decode comes from the index.
+ *
+ * Features:
+ * -scan one byte at a time, the head of the pattern compared at all 8
+ *  bit offsets in the byte against a mask and value table built once
+ * -code boundary check that only moves forward, so no bit of the stream
+ *  is decoded twice
+ * -optional SeekIndex so the boundary check jumps over the gaps between
+ *  candidates
+ *
+ * Assumptions:
+ * -the stream was written with CodeTable::encode from its first bit
+ * -every pattern symbol must have a code, or nothing matches
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "CompressedSearch.h"
+
+/**
+ * Overloaded constructor
+ * this function encodes pattern with table
+ * Preconditions: table must outlive the CompressedSearch
+ * Postconditions: CompressedSearch is ready to search streams coded
+ * with table
+ * @param table: CodeTable the streams are coded with
+ * @param pattern: pointer to the symbols to look for
+ * @param size: number of symbols in the pattern
+ */
+CompressedSearch::CompressedSearch(const CodeTable &table,
+											  const uint8_t *pattern, size_t size)
+	 : table_(table), patternSize_(size)
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		if (pattern[i] >= table.size() || table.getLength(pattern[i]) == 0)
+		{
+			return;
+		}
+	}
+	BitWriter writer(patternCodes_);
+	table.encode(pattern, size, writer);
+	patternBits_ = writer.bitCount();
+	writer.flush();
+}
+
+uint64_t CompressedSearch::getPatternBits() const
+{
+	return patternBits_;
+}
+
+/**
+ * find
+ * this function returns the symbol offset of every match of the
+ * pattern, overlapping matches included
+ * Preconditions: data must be coded with the table given to the
+ * constructor, index (if not nullptr) must be built for the same data
+ * Postconditions: returns the offsets in increasing order
+ * @param data: pointer to the first byte of the packed codes
+ * @param size: number of bytes available
+ * @param numSymbols: number of symbols in the stream
+ * @param index: checkpoints for the stream, or nullptr
+ * @return: symbol offset of each match
+ */
+vector<size_t> CompressedSearch::find(const uint8_t *data, size_t size,
+												  size_t numSymbols,
+												  const SeekIndex *index) const
+{
+	vector<size_t> matches;
+	uint64_t totalBits = (uint64_t)size * 8;
+	if (patternBits_ == 0 || patternBits_ > totalBits)
+	{
+		return matches;
+	}
+
+	// the first head bits of the pattern, placed at each of the 8 bit
+	// offsets a match can start at inside a byte
+	int head = patternBits_ < SEARCH_HEAD_BITS ? patternBits_ : SEARCH_HEAD_BITS;
+	BitReader patternReader(patternCodes_.data(), patternCodes_.size());
+	uint64_t patternHead = patternReader.peek(head);
+	uint64_t headMask[8];
+	uint64_t headBits[8];
+	for (int shift = 0; shift < 8; shift++)
+	{
+		headMask[shift] = (((uint64_t)1 << head) - 1) << (64 - head - shift);
+		headBits[shift] = patternHead << (64 - head - shift);
+	}
+
+	// last known code boundary: symbol and its bit position
+	BitReader sync(data, size);
+	size_t syncSymbol = 0;
+
+	// the window holds the 8 bytes from byte on, zero past the end of
+	// the data, and takes in one new byte per step
+	BitReader tail(data, size);
+	uint64_t window = 0;
+	for (size_t k = 0; k < 7; k++)
+	{
+		window = (window << 8) | (k < size ? data[k] : 0);
+	}
+	for (size_t byte = 0; (uint64_t)byte * 8 + patternBits_ <= totalBits; byte++)
+	{
+		window = (window << 8) | (byte + 7 < size ? data[byte + 7] : 0);
+		for (int shift = 0; shift < 8; shift++)
+		{
+			uint64_t start = (uint64_t)byte * 8 + shift;
+			if ((window & headMask[shift]) != headBits[shift] ||
+				 start + patternBits_ > totalBits)
+			{
+				continue;
+			}
+
+			// compare the rest of the pattern
+			bool same = true;
+			patternReader.seek(head);
+			tail.seek(start + head);
+			while (same && patternReader.position() < patternBits_)
+			{
+				uint64_t left = patternBits_ - patternReader.position();
+				int count = left < MAX_BITS_PER_CALL ? left : MAX_BITS_PER_CALL;
+				same = patternReader.read(count) == tail.read(count);
+			}
+			if (!same)
+			{
+				continue;
+			}
+
+			// jump the boundary check to the nearest checkpoint before start
+			if (index != nullptr)
+			{
+				size_t low = 0;
+				size_t high = index->getNumCheckpoints();
+				while (high - low > 1)
+				{
+					size_t middle = (low + high) / 2;
+					if (index->getBitOffset(middle) <= start)
+					{
+						low = middle;
+					}
+					else
+					{
+						high = middle;
+					}
+				}
+				if (low * index->getInterval() > syncSymbol)
+				{
+					syncSymbol = low * index->getInterval();
+					sync.seek(index->getBitOffset(low));
+				}
+			}
+
+			// decode forward until the boundary reaches start
+			while (sync.position() < start && syncSymbol < numSymbols)
+			{
+				if (table_.decodeSymbol(sync) < 0)
+				{
+					return matches;
+				}
+				syncSymbol++;
+			}
+			if (syncSymbol + patternSize_ > numSymbols)
+			{
+				return matches;
+			}
+			if (sync.position() == start)
+			{
+				matches.push_back(syncSymbol);
+			}
+		}
+	}
+	return matches;
+}
@@ -0,0 +1,93 @@
+/*
+ * @file CompressedSearch.h
+ * @author Katarina McGaughy
+ * CompressedSearch class: The CompressedSearch class finds a pattern in
+ * a packed code stream without decompressing it. The pattern is encoded
+ * with the same CodeTable, the way getWord encodes a string, and its
+ * bits are compared against the stream at every bit position. A bit
+ * match is only a real match when it starts on a code boundary, so each
+ * candidate is checked by decoding forward from the last known boundary,
+ * or from the nearest SeekIndex checkpoint when an index is given.
+ * Without an index the check decodes every symbol up to the last
+ * candidate, so the saving over a full decode comes from the index.
+ *
+ * Features:
+ * -scan one byte at a time, the head of the pattern compared at all 8
+ *  bit offsets in the byte against a mask and value table built once
+ * -code boundary check that only moves forward, so no bit of the stream
+ *  is decoded twice
+ * -optional SeekIndex so the boundary check jumps over the gaps between
+ *  candidates
+ *
+ * Assumptions:
+ * -the stream was written with CodeTable::encode from its first bit
+ * -every pattern symbol must have a code, or nothing matches
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CodeTable.h"
+#include "SeekIndex.h"
+using namespace std;
+
+// bits of the pattern compared before the rest is read, so the head
+// still fits in a 64 bit window shifted by up to 7 bits
+const int SEARCH_HEAD_BITS = 56;
+
+class CompressedSearch
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * this function encodes pattern with table
+	 * Preconditions: table must outlive the CompressedSearch
+	 * Postconditions: CompressedSearch is ready to search streams coded
+	 * with table
+	 * @param table: CodeTable the streams are coded with
+	 * @param pattern: pointer to the symbols to look for
+	 * @param size: number of symbols in the pattern
+	 */
+	CompressedSearch(const CodeTable &table, const uint8_t *pattern, size_t size);
+
+	/**
+	 * getPatternBits
+	 * Preconditions: none
+	 * Postconditions: returns the number of bits in the encoded pattern,
+	 * 0 if the pattern is empty or has a symbol without a code
+	 * @return: number of bits
+	 */
+	uint64_t getPatternBits() const;
+
+	/**
+	 * find
+	 * this function returns the symbol offset of every match of the
+	 * pattern, overlapping matches included
+	 * Preconditions: data must be coded with the table given to the
+	 * constructor, index (if not nullptr) must be built for the same data
+	 * Postconditions: returns the offsets in increasing order
+	 * @param data: pointer to the first byte of the packed codes
+	 * @param size: number of bytes available
+	 * @param numSymbols: number of symbols in the stream
+	 * @param index: checkpoints for the stream, or nullptr
+	 * @return: symbol offset of each match
+	 */
+	vector<size_t> find(const uint8_t *data, size_t size, size_t numSymbols,
+							  const SeekIndex *index = nullptr) const;
+
+private:
+	const CodeTable &table_;
+
+	size_t patternSize_ = 0;
+
+	// encoded pattern, packed the same way as the stream
+	vector<uint8_t> patternCodes_;
+	uint64_t patternBits_ = 0;
+};
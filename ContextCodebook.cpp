@@ -0,0 +1,363 @@
+/*
+ * @file ContextCodebook.cpp
+ * @author Katarina McGaughy
+ * ContextCodebook class: The ContextCodebook class codes each symbol with
+ * a codebook chosen by the symbol before it (an order-1 model), instead
+ * of one codebook for every position. Previous symbols are mapped to
+ * contexts first: each letter is its own context for the 26 letter
+ * alphabet, while bytes are grouped into letter, digit, space and
+ * punctuation contexts so there is enough data to train each one.
+ *
+ * Features:
+ * -one codebook per context, built with HuffmanAlgorithm::buildCodeLengths
+ * -contexts seen fewer than minContextCount times use the order-0 codebook
+ * -symbols a context has never seen are sent as an escape code followed
+ *  by their order-0 code
+ * -serialize the codebooks with CodebookHeader
+ *
+ * Assumptions:
+ * -symbols are indices from 0 to numSymbols - 1 (letters are c - 'a')
+ * -the first symbol of a message uses a context of its own
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "ContextCodebook.h"
+#include <cctype>
+#include "CodebookHeader.h"
+#include "HuffmanAlgorithm.h"
+#include "Varint.h"
+
+/**
+ * Overloaded constructor
+ * this function counts each symbol of sample under the context of
+ * the symbol before it and builds a codebook for every context that
+ * was seen often enough, plus the order-0 codebook for everything
+ * PreConditions: every sample value must be below numSymbols, and
+ * contextOf must have numSymbols entries
+ * PostConditions: ContextCodebook is ready to encode and decode
+ * @param sample: pointer to the training symbols
+ * @param size: number of training symbols
+ * @param numSymbols: number of symbols in the alphabet
+ * @param contextOf: context of each previous symbol
+ * @param minContextCount: fewest times a context must be seen to get
+ * its own codebook
+ */
+ContextCodebook::ContextCodebook(const uint8_t *sample, size_t size,
+											int numSymbols,
+											const vector<int> &contextOf,
+											int minContextCount)
+	: numSymbols_(numSymbols), contextOf_(contextOf)
+{
+	for (int i = 0; i < numSymbols; i++)
+	{
+		if (contextOf_[i] + 1 > numContexts_)
+		{
+			numContexts_ = contextOf_[i] + 1;
+		}
+	}
+
+	// one row per context plus the start context, last column is escape
+	vector<vector<uint64_t>> counts(numContexts_ + 1,
+												vector<uint64_t>(numSymbols + 1, 0));
+	vector<uint64_t> order0Counts(numSymbols, 1);
+	int previous = -1;
+	for (size_t i = 0; i < size; i++)
+	{
+		int context = previous < 0 ? numContexts_ : contextOf_[previous];
+		counts[context][sample[i]]++;
+		order0Counts[sample[i]]++;
+		previous = sample[i];
+	}
+
+	vector<int> lengths(numSymbols + 1);
+	HuffmanAlgorithm::buildCodeLengths(order0Counts.data(), numSymbols,
+												  MAX_HEADER_CODE_LENGTH, lengths.data());
+	order0_ = CodeTable::fromLengths(lengths.data(), numSymbols, 0);
+
+	tables_.resize(numContexts_ + 1);
+	for (int c = 0; c <= numContexts_; c++)
+	{
+		uint64_t total = 0;
+		bool missing = false;
+		for (int s = 0; s < numSymbols; s++)
+		{
+			total += counts[c][s];
+			missing = missing || counts[c][s] == 0;
+		}
+		if (total < (uint64_t)minContextCount)
+		{
+			continue;
+		}
+		// keep an escape code only if some symbol was never seen here
+		counts[c][numSymbols] = missing ? 1 : 0;
+		HuffmanAlgorithm::buildCodeLengths(counts[c].data(), numSymbols + 1,
+													  MAX_HEADER_CODE_LENGTH,
+													  lengths.data());
+		tables_[c] = CodeTable::fromLengths(lengths.data(), numSymbols + 1, 0);
+	}
+}
+
+/**
+ * letterContexts
+ * Preconditions: none
+ * Postconditions: returns one context per letter, 26 x 26 codebooks
+ * @return: context of each letter
+ */
+vector<int> ContextCodebook::letterContexts()
+{
+	vector<int> contexts(NUM_LETTERS);
+	for (int i = 0; i < NUM_LETTERS; i++)
+	{
+		contexts[i] = i;
+	}
+	return contexts;
+}
+
+/**
+ * byteContexts
+ * Preconditions: none
+ * Postconditions: returns grouped contexts for the 256 byte values:
+ * one per letter (either case), then digits, whitespace,
+ * punctuation and everything else
+ * @return: context of each byte value
+ */
+vector<int> ContextCodebook::byteContexts()
+{
+	vector<int> contexts(256);
+	for (int i = 0; i < 256; i++)
+	{
+		if (isalpha(i) && i < 128)
+		{
+			contexts[i] = tolower(i) - 'a';
+		}
+		else if (isdigit(i))
+		{
+			contexts[i] = NUM_LETTERS;
+		}
+		else if (isspace(i))
+		{
+			contexts[i] = NUM_LETTERS + 1;
+		}
+		else if (ispunct(i))
+		{
+			contexts[i] = NUM_LETTERS + 2;
+		}
+		else
+		{
+			contexts[i] = NUM_LETTERS + 3;
+		}
+	}
+	return contexts;
+}
+
+/**
+ * tableFor
+ * Preconditions: previous must be -1 or a symbol
+ * Postconditions: returns the codebook for the context of previous,
+ * or nullptr if that context uses the order-0 codebook
+ */
+const CodeTable *ContextCodebook::tableFor(int previous) const
+{
+	int context = previous < 0 ? numContexts_ : contextOf_[previous];
+	return tables_[context].get();
+}
+
+/**
+ * encode
+ * Preconditions: every symbol must be below the alphabet size
+ * Postconditions: the codes for symbols are written to out
+ * @param symbols: pointer to the symbols
+ * @param size: number of symbols
+ * @param out: BitWriter the codes are written to
+ */
+void ContextCodebook::encode(const uint8_t *symbols, size_t size,
+									  BitWriter &out) const
+{
+	int previous = -1;
+	for (size_t i = 0; i < size; i++)
+	{
+		const CodeTable *table = tableFor(previous);
+		int symbol = symbols[i];
+		if (table != nullptr && table->getLength(symbol) > 0)
+		{
+			table->encodeSymbol(symbol, out);
+		}
+		else
+		{
+			if (table != nullptr)
+			{
+				table->encodeSymbol(numSymbols_, out);
+			}
+			order0_->encodeSymbol(symbol, out);
+		}
+		previous = symbol;
+	}
+}
+
+/**
+ * decode
+ * Preconditions: none
+ * Postconditions: count symbols are appended to out, returns false
+ * if the data ends early
+ * @param in: BitReader positioned at the first code
+ * @param count: number of symbols to read
+ * @param out: vector the symbols are appended to
+ * @return: true if count symbols were read
+ */
+bool ContextCodebook::decode(BitReader &in, size_t count,
+									  vector<uint8_t> &out) const
+{
+	int previous = -1;
+	for (size_t i = 0; i < count; i++)
+	{
+		const CodeTable *table = tableFor(previous);
+		int symbol = table != nullptr ? table->decodeSymbol(in) : numSymbols_;
+		if (symbol == numSymbols_)
+		{
+			symbol = order0_->decodeSymbol(in);
+		}
+		if (symbol < 0)
+		{
+			return false;
+		}
+		out.push_back((uint8_t)symbol);
+		previous = symbol;
+	}
+	return true;
+}
+
+/**
+ * serialize
+ * this function writes the alphabet size, the context map, the
+ * order-0 header and a header for each context with its own codebook
+ * Preconditions: none
+ * Postconditions: the bytes are appended to out
+ * @param out: vector the bytes are appended to
+ */
+void ContextCodebook::serialize(vector<uint8_t> &out) const
+{
+	writeVarint(numSymbols_, out);
+	for (int i = 0; i < numSymbols_; i++)
+	{
+		writeVarint(contextOf_[i], out);
+	}
+
+	vector<int> lengths(numSymbols_ + 1);
+	for (int i = 0; i < numSymbols_; i++)
+	{
+		lengths[i] = order0_->getLength(i);
+	}
+	CodebookHeader::write(lengths.data(), numSymbols_, out);
+
+	for (int c = 0; c <= numContexts_; c++)
+	{
+		if (tables_[c] == nullptr)
+		{
+			out.push_back(0);
+			continue;
+		}
+		out.push_back(1);
+		for (int i = 0; i <= numSymbols_; i++)
+		{
+			lengths[i] = tables_[c]->getLength(i);
+		}
+		CodebookHeader::write(lengths.data(), numSymbols_ + 1, out);
+	}
+}
+
+/**
+ * deserialize
+ * Preconditions: none
+ * Postconditions: returns the ContextCodebook, or nullptr if the bytes
+ * are malformed
+ * @param data: pointer to the serialized codebooks
+ * @param size: number of bytes available
+ * @param used: set to the number of bytes read
+ * @return: the ContextCodebook or nullptr
+ */
+shared_ptr<const ContextCodebook> ContextCodebook::deserialize(
+	const uint8_t *data, size_t size, size_t &used)
+{
+	shared_ptr<ContextCodebook> book(new ContextCodebook());
+	size_t pos = 0;
+	uint64_t value = 0;
+	size_t n = readVarint(data, size, value);
+	if (n == 0 || value == 0 || value > 256)
+	{
+		return nullptr;
+	}
+	pos += n;
+	book->numSymbols_ = value;
+	book->contextOf_.resize(value);
+	for (int i = 0; i < book->numSymbols_; i++)
+	{
+		n = readVarint(data + pos, size - pos, value);
+		if (n == 0 || value >= 256)
+		{
+			return nullptr;
+		}
+		pos += n;
+		book->contextOf_[i] = value;
+		if ((int)value + 1 > book->numContexts_)
+		{
+			book->numContexts_ = value + 1;
+		}
+	}
+
+	vector<int> lengths(book->numSymbols_ + 1);
+	int numSymbols = 0;
+	n = CodebookHeader::read(data + pos, size - pos, lengths.data(),
+									 book->numSymbols_, numSymbols);
+	if (n == 0 || numSymbols != book->numSymbols_)
+	{
+		return nullptr;
+	}
+	pos += n;
+	book->order0_ = CodeTable::fromLengths(lengths.data(), numSymbols, 0);
+
+	book->tables_.resize(book->numContexts_ + 1);
+	for (int c = 0; c <= book->numContexts_; c++)
+	{
+		if (pos >= size)
+		{
+			return nullptr;
+		}
+		if (data[pos++] == 0)
+		{
+			continue;
+		}
+		n = CodebookHeader::read(data + pos, size - pos, lengths.data(),
+										 book->numSymbols_ + 1, numSymbols);
+		if (n == 0 || numSymbols != book->numSymbols_ + 1)
+		{
+			return nullptr;
+		}
+		pos += n;
+		book->tables_[c] = CodeTable::fromLengths(lengths.data(), numSymbols, 0);
+	}
+	used = pos;
+	return book;
+}
+
+/**
+ * getNumTables
+ * Preconditions: none
+ * Postconditions: returns how many contexts have their own codebook
+ * @return: number of context codebooks
+ */
+int ContextCodebook::getNumTables() const
+{
+	int numTables = 0;
+	for (size_t c = 0; c < tables_.size(); c++)
+	{
+		if (tables_[c] != nullptr)
+		{
+			numTables++;
+		}
+	}
+	return numTables;
+}
@@ -0,0 +1,162 @@
+/*
+ * @file ContextCodebook.h
+ * @author Katarina McGaughy
+ * ContextCodebook class: The ContextCodebook class codes each symbol with
+ * a codebook chosen by the symbol before it (an order-1 model), instead
+ * of one codebook for every position. Previous symbols are mapped to
+ * contexts first: each letter is its own context for the 26 letter
+ * alphabet, while bytes are grouped into letter, digit, space and
+ * punctuation contexts so there is enough data to train each one.
+ *
+ * Features:
+ * -one codebook per context, built with HuffmanAlgorithm::buildCodeLengths
+ * -contexts seen fewer than minContextCount times use the order-0 codebook
+ * -symbols a context has never seen are sent as an escape code followed
+ *  by their order-0 code
+ * -serialize the codebooks with CodebookHeader
+ *
+ * Assumptions:
+ * -symbols are indices from 0 to numSymbols - 1 (letters are c - 'a')
+ * -the first symbol of a message uses a context of its own
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BitStream.h"
+#include "CodeTable.h"
+using namespace std;
+
+// contexts seen fewer times than this use the order-0 codebook
+const int DEFAULT_MIN_CONTEXT_COUNT = 64;
+
+class ContextCodebook
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * this function counts each symbol of sample under the context of
+	 * the symbol before it and builds a codebook for every context that
+	 * was seen often enough, plus the order-0 codebook for everything
+	 * PreConditions: every sample value must be below numSymbols, and
+	 * contextOf must have numSymbols entries
+	 * PostConditions: ContextCodebook is ready to encode and decode
+	 * @param sample: pointer to the training symbols
+	 * @param size: number of training symbols
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param contextOf: context of each previous symbol
+	 * @param minContextCount: fewest times a context must be seen to get
+	 * its own codebook
+	 */
+	ContextCodebook(const uint8_t *sample, size_t size, int numSymbols,
+						 const vector<int> &contextOf,
+						 int minContextCount = DEFAULT_MIN_CONTEXT_COUNT);
+
+	/**
+	 * letterContexts
+	 * Preconditions: none
+	 * Postconditions: returns one context per letter, 26 x 26 codebooks
+	 * @return: context of each letter
+	 */
+	static vector<int> letterContexts();
+
+	/**
+	 * byteContexts
+	 * Preconditions: none
+	 * Postconditions: returns grouped contexts for the 256 byte values:
+	 * one per letter (either case), then digits, whitespace,
+	 * punctuation and everything else
+	 * @return: context of each byte value
+	 */
+	static vector<int> byteContexts();
+
+	/**
+	 * encode
+	 * Preconditions: every symbol must be below the alphabet size
+	 * Postconditions: the codes for symbols are written to out
+	 * @param symbols: pointer to the symbols
+	 * @param size: number of symbols
+	 * @param out: BitWriter the codes are written to
+	 */
+	void encode(const uint8_t *symbols, size_t size, BitWriter &out) const;
+
+	/**
+	 * decode
+	 * Preconditions: none
+	 * Postconditions: count symbols are appended to out, returns false
+	 * if the data ends early
+	 * @param in: BitReader positioned at the first code
+	 * @param count: number of symbols to read
+	 * @param out: vector the symbols are appended to
+	 * @return: true if count symbols were read
+	 */
+	bool decode(BitReader &in, size_t count, vector<uint8_t> &out) const;
+
+	/**
+	 * serialize
+	 * this function writes the alphabet size, the context map, the
+	 * order-0 header and a header for each context with its own codebook
+	 * Preconditions: none
+	 * Postconditions: the bytes are appended to out
+	 * @param out: vector the bytes are appended to
+	 */
+	void serialize(vector<uint8_t> &out) const;
+
+	/**
+	 * deserialize
+	 * Preconditions: none
+	 * Postconditions: returns the ContextCodebook, or nullptr if the bytes
+	 * are malformed
+	 * @param data: pointer to the serialized codebooks
+	 * @param size: number of bytes available
+	 * @param used: set to the number of bytes read
+	 * @return: the ContextCodebook or nullptr
+	 */
+	static shared_ptr<const ContextCodebook> deserialize(const uint8_t *data,
+																		  size_t size,
+																		  size_t &used);
+
+	/**
+	 * getNumTables
+	 * Preconditions: none
+	 * Postconditions: returns how many contexts have their own codebook
+	 * @return: number of context codebooks
+	 */
+	int getNumTables() const;
+
+private:
+	/**
+	 * default constructor, used by deserialize
+	 */
+	ContextCodebook() {}
+
+	/**
+	 * tableFor
+	 * Preconditions: previous must be -1 or a symbol
+	 * Postconditions: returns the codebook for the context of previous,
+	 * or nullptr if that context uses the order-0 codebook
+	 */
+	const CodeTable *tableFor(int previous) const;
+
+	int numSymbols_ = 0;
+
+	// context of each symbol, and the number of contexts. Context
+	// numContexts_ is the start of a message
+	vector<int> contextOf_;
+	int numContexts_ = 0;
+
+	// codebook for all symbols, every symbol has a code
+	shared_ptr<const CodeTable> order0_;
+
+	// codebook for each context, symbol numSymbols_ is the escape code.
+	// nullptr for contexts that use order0_
+	vector<shared_ptr<const CodeTable>> tables_;
+};
@@ -0,0 +1,270 @@
+/*
+ * @file Crc32c.cpp
+ * @author Katarina McGaughy
+ * crc32c function: computes the CRC-32C (Castagnoli) checksum used to
+ * check blocks for corruption. On x86-64 processors with SSE4.2 the
+ * crc32 instruction is used on three parts of the data at once, since
+ * each instruction has a latency of three cycles but a new one can
+ * start every cycle. The three CRCs are then joined by shifting with
+ * precomputed tables. Other processors use a slicing-by-8 table.
+ * RunningCrc32c class: The RunningCrc32c class checksums a vector while
+ * it is being written, folding each CRC_FOLD_BYTES of new bytes into
+ * the CRC while they are still in the L1 cache, so the CRC is not a
+ * second pass over the finished block.
+ *
+ * Assumptions:
+ * -the processor is checked once, at the first call
+ * -crc32c(b, crc32c(a)) equals the CRC of a followed by b
+ * -bytes a RunningCrc32c has folded are not changed afterwards
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "Crc32c.h"
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <nmmintrin.h>
+#define CRC32C_HARDWARE 1
+#endif
+
+// CRC-32C polynomial, bit reversed
+static const uint32_t CRC32C_POLY = 0x82F63B78;
+
+// bytes in each of the three parts, long parts for large buffers and
+// short parts for what is left
+static const size_t CRC32C_LONG = 8192;
+static const size_t CRC32C_SHORT = 256;
+
+/**
+ * multModP
+ * Preconditions: none
+ * Postconditions: returns a times b modulo the polynomial, with bits
+ * reversed as the CRC holds them
+ */
+static uint32_t multModP(uint32_t a, uint32_t b)
+{
+	uint32_t product = 0;
+	for (uint32_t m = (uint32_t)1 << 31; m != 0; m >>= 1)
+	{
+		if (a & m)
+		{
+			product ^= b;
+		}
+		b = (b & 1) ? (b >> 1) ^ CRC32C_POLY : b >> 1;
+	}
+	return product;
+}
+
+/**
+ * Crc32cTables struct holds every table, built once at the first call
+ */
+struct Crc32cTables
+{
+	// slicing-by-8 tables, slice[0] is the usual byte table
+	uint32_t slice[8][256];
+
+	// shift a CRC over CRC32C_LONG or CRC32C_SHORT zero bytes, a byte
+	// of the CRC at a time
+	uint32_t shiftLong[4][256];
+	uint32_t shiftShort[4][256];
+
+	bool hardware = false;
+
+	Crc32cTables()
+	{
+		for (uint32_t b = 0; b < 256; b++)
+		{
+			uint32_t crc = b;
+			for (int k = 0; k < 8; k++)
+			{
+				crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+			}
+			slice[0][b] = crc;
+		}
+		for (uint32_t b = 0; b < 256; b++)
+		{
+			for (int k = 1; k < 8; k++)
+			{
+				slice[k][b] = (slice[k - 1][b] >> 8) ^ slice[0][slice[k - 1][b] & 0xFF];
+			}
+		}
+		buildShift(CRC32C_LONG, shiftLong);
+		buildShift(CRC32C_SHORT, shiftShort);
+#ifdef CRC32C_HARDWARE
+		hardware = __builtin_cpu_supports("sse4.2");
+#endif
+	}
+
+	/**
+	 * buildShift
+	 * Preconditions: none
+	 * Postconditions: shift holds the tables that multiply a CRC by
+	 * x^(8 * bytes), the same as running it over that many zero bytes
+	 */
+	void buildShift(size_t bytes, uint32_t shift[4][256])
+	{
+		// x^8 is the CRC state one zero byte moves by, start from x^0
+		uint32_t power = (uint32_t)1 << 31;
+		uint32_t square = (uint32_t)1 << 23;
+		for (size_t n = bytes; n > 0; n >>= 1)
+		{
+			if (n & 1)
+			{
+				power = multModP(square, power);
+			}
+			square = multModP(square, square);
+		}
+		for (int k = 0; k < 4; k++)
+		{
+			for (uint32_t b = 0; b < 256; b++)
+			{
+				shift[k][b] = multModP(power, b << (8 * k));
+			}
+		}
+	}
+};
+
+static const Crc32cTables &tables()
+{
+	static const Crc32cTables built;
+	return built;
+}
+
+/**
+ * shiftCrc
+ * Preconditions: none
+ * Postconditions: returns crc moved over the zero bytes of shift
+ */
+static inline uint32_t shiftCrc(const uint32_t shift[4][256], uint32_t crc)
+{
+	return shift[0][crc & 0xFF] ^ shift[1][(crc >> 8) & 0xFF] ^
+			 shift[2][(crc >> 16) & 0xFF] ^ shift[3][crc >> 24];
+}
+
+/**
+ * crcSoftware
+ * Preconditions: none
+ * Postconditions: returns crc moved over data eight bytes at a time
+ */
+static uint32_t crcSoftware(const Crc32cTables &t, uint32_t crc,
+									 const uint8_t *data, size_t size)
+{
+	while (size >= 8)
+	{
+		uint64_t word;
+		memcpy(&word, data, 8);
+		// the tables assume the bytes are in little endian order
+		word ^= crc;
+		crc = t.slice[7][word & 0xFF] ^ t.slice[6][(word >> 8) & 0xFF] ^
+				t.slice[5][(word >> 16) & 0xFF] ^ t.slice[4][(word >> 24) & 0xFF] ^
+				t.slice[3][(word >> 32) & 0xFF] ^ t.slice[2][(word >> 40) & 0xFF] ^
+				t.slice[1][(word >> 48) & 0xFF] ^ t.slice[0][word >> 56];
+		data += 8;
+		size -= 8;
+	}
+	while (size > 0)
+	{
+		crc = (crc >> 8) ^ t.slice[0][(crc ^ *data) & 0xFF];
+		data++;
+		size--;
+	}
+	return crc;
+}
+
+#ifdef CRC32C_HARDWARE
+/**
+ * crcParts
+ * Preconditions: size must be a multiple of 8 and data must hold three
+ * parts of size bytes
+ * Postconditions: returns crc moved over all three parts, running the
+ * crc32 instruction on each part in turn so they overlap
+ */
+__attribute__((target("sse4.2"))) static uint32_t
+crcParts(const uint32_t shift[4][256], uint32_t crc, const uint8_t *data,
+			size_t size)
+{
+	uint64_t crc0 = crc;
+	uint64_t crc1 = 0;
+	uint64_t crc2 = 0;
+	for (size_t i = 0; i < size; i += 8)
+	{
+		uint64_t word0, word1, word2;
+		memcpy(&word0, data + i, 8);
+		memcpy(&word1, data + size + i, 8);
+		memcpy(&word2, data + 2 * size + i, 8);
+		crc0 = _mm_crc32_u64(crc0, word0);
+		crc1 = _mm_crc32_u64(crc1, word1);
+		crc2 = _mm_crc32_u64(crc2, word2);
+	}
+	// a CRC of part A followed by part B is A's CRC moved over B's
+	// length, xor the CRC of B on its own
+	crc = shiftCrc(shift, (uint32_t)crc0) ^ (uint32_t)crc1;
+	return shiftCrc(shift, crc) ^ (uint32_t)crc2;
+}
+
+/**
+ * crcHardware
+ * Preconditions: the processor must support SSE4.2
+ * Postconditions: returns crc moved over data
+ */
+__attribute__((target("sse4.2"))) static uint32_t
+crcHardware(const Crc32cTables &t, uint32_t crc, const uint8_t *data,
+				size_t size)
+{
+	while (size >= 3 * CRC32C_LONG)
+	{
+		crc = crcParts(t.shiftLong, crc, data, CRC32C_LONG);
+		data += 3 * CRC32C_LONG;
+		size -= 3 * CRC32C_LONG;
+	}
+	while (size >= 3 * CRC32C_SHORT)
+	{
+		crc = crcParts(t.shiftShort, crc, data, CRC32C_SHORT);
+		data += 3 * CRC32C_SHORT;
+		size -= 3 * CRC32C_SHORT;
+	}
+	uint64_t crc64 = crc;
+	while (size >= 8)
+	{
+		uint64_t word;
+		memcpy(&word, data, 8);
+		crc64 = _mm_crc32_u64(crc64, word);
+		data += 8;
+		size -= 8;
+	}
+	crc = (uint32_t)crc64;
+	while (size > 0)
+	{
+		crc = _mm_crc32_u8(crc, *data);
+		data++;
+		size--;
+	}
+	return crc;
+}
+#endif
+
+/**
+ * crc32c
+ * Preconditions: none
+ * Postconditions: returns the CRC-32C of data, continuing from crc
+ * @param data: pointer to the bytes
+ * @param size: number of bytes
+ * @param crc: CRC of the bytes before data, 0 to start
+ * @return: the CRC-32C
+ */
+uint32_t crc32c(const uint8_t *data, size_t size, uint32_t crc)
+{
+	const Crc32cTables &t = tables();
+	crc = ~crc;
+#ifdef CRC32C_HARDWARE
+	if (t.hardware)
+	{
+		return ~crcHardware(t, crc, data, size);
+	}
+#endif
+	return ~crcSoftware(t, crc, data, size);
+}
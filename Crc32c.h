@@ -0,0 +1,115 @@
+/*
+ * @file Crc32c.h
+ * @author Katarina McGaughy
+ * crc32c function: computes the CRC-32C (Castagnoli) checksum used to
+ * check blocks for corruption. On x86-64 processors with SSE4.2 the
+ * crc32 instruction is used on three parts of the data at once, since
+ * each instruction has a latency of three cycles but a new one can
+ * start every cycle. The three CRCs are then joined by shifting with
+ * precomputed tables. Other processors use a slicing-by-8 table.
+ * RunningCrc32c class: The RunningCrc32c class checksums a vector while
+ * it is being written, folding each CRC_FOLD_BYTES of new bytes into
+ * the CRC while they are still in the L1 cache, so the CRC is not a
+ * second pass over the finished block.
+ *
+ * Assumptions:
+ * -the processor is checked once, at the first call
+ * -crc32c(b, crc32c(a)) equals the CRC of a followed by b
+ * -bytes a RunningCrc32c has folded are not changed afterwards
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// new bytes a RunningCrc32c waits for before folding them, enough for
+// the three way crc32 loop and few enough to still be in the L1 cache
+const size_t CRC_FOLD_BYTES = 4096;
+
+/**
+ * crc32c
+ * Preconditions: none
+ * Postconditions: returns the CRC-32C of data, continuing from crc
+ * @param data: pointer to the bytes
+ * @param size: number of bytes
+ * @param crc: CRC of the bytes before data, 0 to start
+ * @return: the CRC-32C
+ */
+uint32_t crc32c(const uint8_t *data, size_t size, uint32_t crc = 0);
+
+class RunningCrc32c
+{
+public:
+	/**
+	 * constructor
+	 * Preconditions: out must outlive the RunningCrc32c
+	 * Postconditions: the bytes of out from start on are checksummed as
+	 * they are folded
+	 * @param out: vector being written
+	 * @param start: index of the first byte to checksum
+	 */
+	RunningCrc32c(const vector<uint8_t> &out, size_t start)
+		: out_(out), start_(start), folded_(start)
+	{
+	}
+
+	/**
+	 * fold
+	 * this function folds the bytes written since the last fold into
+	 * the CRC once there are at least CRC_FOLD_BYTES of them
+	 * Preconditions: the bytes of out before end must be final
+	 * Postconditions: the CRC covers the bytes up to end, or up to an
+	 * earlier fold
+	 * @param end: index one past the last final byte
+	 */
+	void fold(size_t end)
+	{
+		if (end - folded_ >= CRC_FOLD_BYTES)
+		{
+			crc_ = crc32c(out_.data() + folded_, end - folded_, crc_);
+			folded_ = end;
+		}
+	}
+
+	/**
+	 * finish
+	 * Preconditions: the bytes of out before end must be final
+	 * Postconditions: returns the CRC-32C of the bytes from start to end
+	 * @param end: index one past the last byte
+	 * @return: the CRC-32C
+	 */
+	uint32_t finish(size_t end)
+	{
+		crc_ = crc32c(out_.data() + folded_, end - folded_, crc_);
+		folded_ = end;
+		return crc_;
+	}
+
+	/**
+	 * restart
+	 * Preconditions: none
+	 * Postconditions: nothing is folded, for when the bytes from start
+	 * on are thrown away and written again
+	 */
+	void restart()
+	{
+		crc_ = 0;
+		folded_ = start_;
+	}
+
+private:
+	const vector<uint8_t> &out_;
+	size_t start_;
+
+	// bytes of out before folded_ are in crc_
+	size_t folded_;
+	uint32_t crc_ = 0;
+};
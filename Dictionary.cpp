@@ -0,0 +1,150 @@
+/*
+ * @file Dictionary.cpp
+ * @author Katarina McGaughy
+ * Dictionary class: The Dictionary class is a trained byte codebook with
+ * an ID. Encoder and decoder both load the dictionary ahead of time, so
+ * a block only names the ID instead of carrying its own header. This
+ * suits messages of a few hundred bytes, which are too short to pay for
+ * a header or to give good statistics of their own.
+ *
+ * Features:
+ * -ID and code lengths for all 256 byte values
+ * -shared CodeTable for encoding and decoding
+ * -serialize to and from bytes or a dictionary file
+ *
+ * File format:
+ * -the 4 bytes "HDIC"
+ * -dictionary ID as a varint
+ * -CodebookHeader with the code lengths
+ *
+ * Assumptions:
+ * -a Dictionary is never modified after construction
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "Dictionary.h"
+#include <fstream>
+#include <iterator>
+#include "CodebookHeader.h"
+#include "Varint.h"
+
+// first bytes of every dictionary file
+static const uint8_t DICTIONARY_MAGIC[4] = {'H', 'D', 'I', 'C'};
+
+/**
+ * Overloaded constructor
+ * Preconditions: lengths must form a prefix code of at most
+ * MAX_HEADER_CODE_LENGTH bits
+ * Postconditions: Dictionary with canonical codes for lengths
+ * @param id: ID blocks use to refer to this dictionary
+ * @param lengths: integer array of code lengths for each byte value
+ */
+Dictionary::Dictionary(uint32_t id, const int (&lengths)[NUM_BYTE_SYMBOLS])
+	: id_(id)
+{
+	for (int i = 0; i < NUM_BYTE_SYMBOLS; i++)
+	{
+		lengths_[i] = lengths[i];
+	}
+	table_ = CodeTable::fromLengths(lengths_, NUM_BYTE_SYMBOLS, 0);
+}
+
+uint32_t Dictionary::getId() const
+{
+	return id_;
+}
+
+const CodeTable &Dictionary::getCodeTable() const
+{
+	return *table_;
+}
+
+int Dictionary::getLength(int symbol) const
+{
+	return lengths_[symbol];
+}
+
+/**
+ * serialize
+ * Preconditions: none
+ * Postconditions: the dictionary file bytes are appended to out
+ * @param out: vector the bytes are appended to
+ */
+void Dictionary::serialize(vector<uint8_t> &out) const
+{
+	out.insert(out.end(), DICTIONARY_MAGIC, DICTIONARY_MAGIC + 4);
+	writeVarint(id_, out);
+	CodebookHeader::write(lengths_, NUM_BYTE_SYMBOLS, out);
+}
+
+/**
+ * deserialize
+ * Preconditions: none
+ * Postconditions: returns the Dictionary, or nullptr if the bytes
+ * are not a valid dictionary
+ * @param data: pointer to the dictionary bytes
+ * @param size: number of bytes
+ * @return: the Dictionary or nullptr
+ */
+shared_ptr<const Dictionary> Dictionary::deserialize(const uint8_t *data,
+																	  size_t size)
+{
+	if (size < 4 || !equal(DICTIONARY_MAGIC, DICTIONARY_MAGIC + 4, data))
+	{
+		return nullptr;
+	}
+	uint64_t id = 0;
+	size_t used = readVarint(data + 4, size - 4, id);
+	if (used == 0 || id > UINT32_MAX)
+	{
+		return nullptr;
+	}
+	int lengths[NUM_BYTE_SYMBOLS] = {};
+	int numSymbols = 0;
+	if (CodebookHeader::read(data + 4 + used, size - 4 - used, lengths,
+									 NUM_BYTE_SYMBOLS, numSymbols) == 0)
+	{
+		return nullptr;
+	}
+	return make_shared<const Dictionary>(id, lengths);
+}
+
+/**
+ * writeFile
+ * Preconditions: none
+ * Postconditions: writes the dictionary to path, returns true on success
+ * @param path: dictionary file name
+ * @return: true if the file was written
+ */
+bool Dictionary::writeFile(const string &path) const
+{
+	vector<uint8_t> bytes;
+	serialize(bytes);
+	ofstream file(path, ios::binary);
+	file.write((const char *)bytes.data(), bytes.size());
+	return (bool)file;
+}
+
+/**
+ * readFile
+ * Preconditions: none
+ * Postconditions: returns the dictionary stored in path, or nullptr if
+ * it cannot be read
+ * @param path: dictionary file name
+ * @return: the Dictionary or nullptr
+ */
+shared_ptr<const Dictionary> Dictionary::readFile(const string &path)
+{
+	ifstream file(path, ios::binary);
+	if (!file)
+	{
+		return nullptr;
+	}
+	vector<uint8_t> bytes((istreambuf_iterator<char>(file)),
+								 istreambuf_iterator<char>());
+	return deserialize(bytes.data(), bytes.size());
+}
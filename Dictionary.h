@@ -0,0 +1,105 @@
+/*
+ * @file Dictionary.h
+ * @author Katarina McGaughy
+ * Dictionary class: The Dictionary class is a trained byte codebook with
+ * an ID. Encoder and decoder both load the dictionary ahead of time, so
+ * a block only names the ID instead of carrying its own header. This
+ * suits messages of a few hundred bytes, which are too short to pay for
+ * a header or to give good statistics of their own.
+ *
+ * Features:
+ * -ID and code lengths for all 256 byte values
+ * -shared CodeTable for encoding and decoding
+ * -serialize to and from bytes or a dictionary file
+ *
+ * File format:
+ * -the 4 bytes "HDIC"
+ * -dictionary ID as a varint
+ * -CodebookHeader with the code lengths
+ *
+ * Assumptions:
+ * -a Dictionary is never modified after construction
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CodeTable.h"
+using namespace std;
+
+// number of symbols in a byte alphabet
+const int NUM_BYTE_SYMBOLS = 256;
+
+class Dictionary
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * Preconditions: lengths must form a prefix code of at most
+	 * MAX_HEADER_CODE_LENGTH bits
+	 * Postconditions: Dictionary with canonical codes for lengths
+	 * @param id: ID blocks use to refer to this dictionary
+	 * @param lengths: integer array of code lengths for each byte value
+	 */
+	Dictionary(uint32_t id, const int (&lengths)[NUM_BYTE_SYMBOLS]);
+
+	/**
+	 * getId, getCodeTable, getLength
+	 * Preconditions: none
+	 * Postconditions: return the ID, the CodeTable, and the code length
+	 * of a byte value
+	 */
+	uint32_t getId() const;
+	const CodeTable &getCodeTable() const;
+	int getLength(int symbol) const;
+
+	/**
+	 * serialize
+	 * Preconditions: none
+	 * Postconditions: the dictionary file bytes are appended to out
+	 * @param out: vector the bytes are appended to
+	 */
+	void serialize(vector<uint8_t> &out) const;
+
+	/**
+	 * deserialize
+	 * Preconditions: none
+	 * Postconditions: returns the Dictionary, or nullptr if the bytes
+	 * are not a valid dictionary
+	 * @param data: pointer to the dictionary bytes
+	 * @param size: number of bytes
+	 * @return: the Dictionary or nullptr
+	 */
+	static shared_ptr<const Dictionary> deserialize(const uint8_t *data,
+																	size_t size);
+
+	/**
+	 * writeFile, readFile
+	 * Preconditions: none
+	 * Postconditions: write the dictionary to path and return true on
+	 * success, or read it back and return nullptr on failure
+	 * @param path: dictionary file name
+	 */
+	bool writeFile(const string &path) const;
+	static shared_ptr<const Dictionary> readFile(const string &path);
+
+private:
+	uint32_t id_;
+
+	// code length of each byte value
+	int lengths_[NUM_BYTE_SYMBOLS];
+
+	shared_ptr<const CodeTable> table_;
+};
+
+// dictionaries known to a decoder, by ID
+typedef unordered_map<uint32_t, shared_ptr<const Dictionary>> DictionarySet;
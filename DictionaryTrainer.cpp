@@ -0,0 +1,85 @@
+/*
+ * @file DictionaryTrainer.cpp
+ * @author Katarina McGaughy
+ * DictionaryTrainer class: The DictionaryTrainer class adds up the byte
+ * counts of a sample corpus and builds a Dictionary from the total, the
+ * same way HuffmanAlgorithm builds a codebook from a counts array.
+ *
+ * Features:
+ * -add samples one at a time, or counts from a Histogram
+ * -train a Dictionary with a given ID
+ *
+ * Assumptions:
+ * -every byte value gets a code, even if it never appears in the
+ *  samples, so any message can be encoded with the dictionary
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "DictionaryTrainer.h"
+#include "CodebookHeader.h"
+#include "HuffmanAlgorithm.h"
+
+/**
+ * addSample
+ * Preconditions: none
+ * Postconditions: the bytes of the sample are added to the counts
+ * @param data: pointer to the sample
+ * @param size: number of bytes
+ */
+void DictionaryTrainer::addSample(const uint8_t *data, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		counts_[data[i]]++;
+	}
+}
+
+/**
+ * addHistogram
+ * this function adds byte counts made elsewhere, such as the merged
+ * histograms of several worker processes
+ * Preconditions: none
+ * Postconditions: returns false and changes nothing if histogram
+ * does not have NUM_BYTE_SYMBOLS symbols, otherwise the counts of
+ * histogram are added to the counts
+ * @param histogram: Histogram of byte values
+ * @return: true if the counts were added
+ */
+bool DictionaryTrainer::addHistogram(const Histogram &histogram)
+{
+	if (histogram.size() != NUM_BYTE_SYMBOLS)
+	{
+		return false;
+	}
+	for (int i = 0; i < NUM_BYTE_SYMBOLS; i++)
+	{
+		counts_[i] += histogram.getCount(i);
+	}
+	return true;
+}
+
+/**
+ * train
+ * this function gives every byte value a count of at least 1 and
+ * builds the code lengths with HuffmanAlgorithm::buildCodeLengths
+ * Preconditions: none
+ * Postconditions: returns the trained Dictionary
+ * @param id: ID of the new dictionary
+ * @return: the trained Dictionary
+ */
+shared_ptr<const Dictionary> DictionaryTrainer::train(uint32_t id) const
+{
+	uint64_t counts[NUM_BYTE_SYMBOLS];
+	for (int i = 0; i < NUM_BYTE_SYMBOLS; i++)
+	{
+		counts[i] = counts_[i] + 1;
+	}
+	int lengths[NUM_BYTE_SYMBOLS];
+	HuffmanAlgorithm::buildCodeLengths(counts, NUM_BYTE_SYMBOLS,
+												  MAX_HEADER_CODE_LENGTH, lengths);
+	return make_shared<const Dictionary>(id, lengths);
+}
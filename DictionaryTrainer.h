@@ -0,0 +1,70 @@
+/*
+ * @file DictionaryTrainer.h
+ * @author Katarina McGaughy
+ * DictionaryTrainer class: The DictionaryTrainer class adds up the byte
+ * counts of a sample corpus and builds a Dictionary from the total, the
+ * same way HuffmanAlgorithm builds a codebook from a counts array.
+ *
+ * Features:
+ * -add samples one at a time, or counts from a Histogram
+ * -train a Dictionary with a given ID
+ *
+ * Assumptions:
+ * -every byte value gets a code, even if it never appears in the
+ *  samples, so any message can be encoded with the dictionary
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Dictionary.h"
+#include "Histogram.h"
+using namespace std;
+
+class DictionaryTrainer
+{
+public:
+	/**
+	 * addSample
+	 * Preconditions: none
+	 * Postconditions: the bytes of the sample are added to the counts
+	 * @param data: pointer to the sample
+	 * @param size: number of bytes
+	 */
+	void addSample(const uint8_t *data, size_t size);
+
+	/**
+	 * addHistogram
+	 * this function adds byte counts made elsewhere, such as the merged
+	 * histograms of several worker processes
+	 * Preconditions: none
+	 * Postconditions: returns false and changes nothing if histogram
+	 * does not have NUM_BYTE_SYMBOLS symbols, otherwise the counts of
+	 * histogram are added to the counts
+	 * @param histogram: Histogram of byte values
+	 * @return: true if the counts were added
+	 */
+	bool addHistogram(const Histogram &histogram);
+
+	/**
+	 * train
+	 * this function gives every byte value a count of at least 1 and
+	 * builds the code lengths with HuffmanAlgorithm::buildCodeLengths
+	 * Preconditions: none
+	 * Postconditions: returns the trained Dictionary
+	 * @param id: ID of the new dictionary
+	 * @return: the trained Dictionary
+	 */
+	shared_ptr<const Dictionary> train(uint32_t id) const;
+
+private:
+	// count of each byte value over all samples
+	uint64_t counts_[NUM_BYTE_SYMBOLS] = {};
+};
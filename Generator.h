@@ -0,0 +1,206 @@
+/*
+ * @file Generator.h
+ * @author Katarina McGaughy
+ * Generator class: The Generator class template is the return type of a
+ * C++20 coroutine that produces a sequence of values with co_yield. The
+ * coroutine does not run until the first value is asked for and stops
+ * at every co_yield until the next one is, so a caller can take values
+ * one at a time, interleave them with other work, or stop early.
+ *
+ * Features:
+ * -range for loops through begin() and end()
+ * -next() and value() for callers that pull values by hand
+ * -a yielded value is not copied, the caller sees the coroutine's own
+ *  object until the coroutine is resumed
+ * -destroying the Generator destroys the coroutine frame, even when
+ *  the sequence was not finished
+ *
+ * Assumptions:
+ * -the coroutine does not throw
+ * -a reference to a value is only used until the Generator is advanced
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <utility>
+using namespace std;
+
+template <typename T>
+class Generator
+{
+public:
+	/**
+	 * promise_type struct is the state the compiler keeps for the
+	 * coroutine, holding the address of the value last yielded
+	 */
+	struct promise_type
+	{
+		const T *current = nullptr;
+
+		Generator get_return_object()
+		{
+			return Generator(coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		// nothing runs until the first value is asked for
+		suspend_always initial_suspend() noexcept
+		{
+			return {};
+		}
+
+		suspend_always final_suspend() noexcept
+		{
+			return {};
+		}
+
+		// the value stays alive in the frame, or as a temporary in the
+		// co_yield expression, while the coroutine is suspended
+		suspend_always yield_value(const T &value) noexcept
+		{
+			current = &value;
+			return {};
+		}
+
+		void return_void()
+		{
+		}
+
+		void unhandled_exception()
+		{
+			terminate();
+		}
+	};
+
+	/**
+	 * Iterator class steps through the values for range for loops
+	 */
+	class Iterator
+	{
+	public:
+		using iterator_category = input_iterator_tag;
+		using value_type = T;
+		using difference_type = ptrdiff_t;
+
+		explicit Iterator(Generator *generator = nullptr)
+			: generator_(generator)
+		{
+		}
+
+		const T &operator*() const
+		{
+			return generator_->value();
+		}
+
+		const T *operator->() const
+		{
+			return &generator_->value();
+		}
+
+		Iterator &operator++()
+		{
+			if (!generator_->next())
+			{
+				generator_ = nullptr;
+			}
+			return *this;
+		}
+
+		bool operator==(const Iterator &other) const
+		{
+			return generator_ == other.generator_;
+		}
+
+	private:
+		Generator *generator_;
+	};
+
+	/**
+	 * Overloaded constructor
+	 * Preconditions: handle must be a suspended coroutine
+	 * Postconditions: the Generator owns the coroutine
+	 * @param handle: coroutine handle from the promise
+	 */
+	explicit Generator(coroutine_handle<promise_type> handle)
+		: handle_(handle)
+	{
+	}
+
+	Generator(Generator &&other) noexcept
+		: handle_(exchange(other.handle_, nullptr))
+	{
+	}
+
+	Generator &operator=(Generator &&other) noexcept
+	{
+		if (this != &other)
+		{
+			if (handle_)
+			{
+				handle_.destroy();
+			}
+			handle_ = exchange(other.handle_, nullptr);
+		}
+		return *this;
+	}
+
+	Generator(const Generator &) = delete;
+	Generator &operator=(const Generator &) = delete;
+
+	~Generator()
+	{
+		if (handle_)
+		{
+			handle_.destroy();
+		}
+	}
+
+	/**
+	 * next
+	 * this function runs the coroutine to its next co_yield
+	 * Preconditions: none
+	 * Postconditions: returns false once the coroutine has finished
+	 * @return: true if value() holds a new value
+	 */
+	bool next()
+	{
+		if (!handle_ || handle_.done())
+		{
+			return false;
+		}
+		handle_.resume();
+		return !handle_.done();
+	}
+
+	/**
+	 * value
+	 * Preconditions: the last call to next() must have returned true
+	 * Postconditions: returns the value last yielded
+	 * @return: reference valid until the next call to next()
+	 */
+	const T &value() const
+	{
+		return *handle_.promise().current;
+	}
+
+	Iterator begin()
+	{
+		return next() ? Iterator(this) : end();
+	}
+
+	Iterator end()
+	{
+		return Iterator();
+	}
+
+private:
+	coroutine_handle<promise_type> handle_;
+};
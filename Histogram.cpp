@@ -0,0 +1,280 @@
+/*
+ * @file Histogram.cpp
+ * @author Katarina McGaughy
+ * Histogram class: The Histogram class holds symbol counts that can be
+ * computed in separate processes and added together later. Each worker
+ * counts its own shard and writes a small histogram file, and one
+ * process merges the files and builds the codebook, so the raw data
+ * never has to be sent to one place just to be counted.
+ *
+ * Features:
+ * -count bytes or add counts for any symbol
+ * -merge another histogram, in any order with the same result
+ * -serialize to and from bytes or a histogram file
+ * -files are written under a temporary name and renamed, so a process
+ *  reading a shared directory never sees half a file
+ *
+ * File format:
+ * -the 4 bytes "HHST"
+ * -number of symbols as a varint
+ * -each count as a varint. A 0 count is followed by a varint holding
+ *  how many more 0 counts come after it
+ *
+ * Assumptions:
+ * -histograms are only merged with histograms of the same alphabet
+ * -counts that would pass UINT64_MAX stay at UINT64_MAX, so adding is
+ *  still commutative and associative
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "Histogram.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include "Varint.h"
+
+// first bytes of every histogram file
+static const uint8_t HISTOGRAM_MAGIC[4] = {'H', 'H', 'S', 'T'};
+
+/**
+ * addSaturating
+ * Preconditions: none
+ * Postconditions: returns a + b, or UINT64_MAX if that does not fit
+ */
+static uint64_t addSaturating(uint64_t a, uint64_t b)
+{
+	return a > UINT64_MAX - b ? UINT64_MAX : a + b;
+}
+
+/**
+ * Overloaded constructor
+ * Preconditions: numSymbols must be between 1 and
+ * MAX_HISTOGRAM_SYMBOLS
+ * Postconditions: Histogram with every count 0
+ * @param numSymbols: number of symbols in the alphabet
+ */
+Histogram::Histogram(int numSymbols) : counts_(numSymbols, 0)
+{
+}
+
+/**
+ * addBytes
+ * Preconditions: every byte must be below size()
+ * Postconditions: each byte value is counted once per occurrence
+ * @param data: pointer to the bytes
+ * @param size: number of bytes
+ */
+void Histogram::addBytes(const uint8_t *data, size_t size)
+{
+	// a local table keeps the loop free of the saturation check
+	uint64_t counts[NUM_BYTE_SYMBOLS] = {};
+	for (size_t i = 0; i < size; i++)
+	{
+		counts[data[i]]++;
+	}
+	for (int s = 0; s < NUM_BYTE_SYMBOLS; s++)
+	{
+		if (counts[s] > 0)
+		{
+			add(s, counts[s]);
+		}
+	}
+}
+
+/**
+ * add
+ * Preconditions: symbol must be below size()
+ * Postconditions: count is added to the count of symbol
+ * @param symbol: index of the symbol
+ * @param count: amount to add
+ */
+void Histogram::add(int symbol, uint64_t count)
+{
+	counts_[symbol] = addSaturating(counts_[symbol], count);
+}
+
+/**
+ * merge
+ * this function adds every count of other to this histogram
+ * Preconditions: none
+ * Postconditions: returns false and changes nothing if the alphabets
+ * differ
+ * @param other: Histogram to add
+ * @return: true if the histograms were merged
+ */
+bool Histogram::merge(const Histogram &other)
+{
+	if (other.counts_.size() != counts_.size())
+	{
+		return false;
+	}
+	for (size_t s = 0; s < counts_.size(); s++)
+	{
+		counts_[s] = addSaturating(counts_[s], other.counts_[s]);
+	}
+	return true;
+}
+
+int Histogram::size() const
+{
+	return (int)counts_.size();
+}
+
+uint64_t Histogram::getCount(int symbol) const
+{
+	return counts_[symbol];
+}
+
+const uint64_t *Histogram::getCounts() const
+{
+	return counts_.data();
+}
+
+uint64_t Histogram::getTotal() const
+{
+	uint64_t total = 0;
+	for (uint64_t count : counts_)
+	{
+		total = addSaturating(total, count);
+	}
+	return total;
+}
+
+bool Histogram::operator==(const Histogram &other) const
+{
+	return counts_ == other.counts_;
+}
+
+/**
+ * serialize
+ * Preconditions: none
+ * Postconditions: the histogram file bytes are appended to out
+ * @param out: vector the bytes are appended to
+ */
+void Histogram::serialize(vector<uint8_t> &out) const
+{
+	out.insert(out.end(), HISTOGRAM_MAGIC, HISTOGRAM_MAGIC + 4);
+	writeVarint(counts_.size(), out);
+	size_t s = 0;
+	while (s < counts_.size())
+	{
+		writeVarint(counts_[s], out);
+		s++;
+		if (counts_[s - 1] == 0)
+		{
+			size_t run = 0;
+			while (s < counts_.size() && counts_[s] == 0)
+			{
+				run++;
+				s++;
+			}
+			writeVarint(run, out);
+		}
+	}
+}
+
+/**
+ * deserialize
+ * Preconditions: none
+ * Postconditions: returns the Histogram, or nullptr if the bytes are
+ * not a valid histogram
+ * @param data: pointer to the histogram bytes
+ * @param size: number of bytes
+ * @return: the Histogram or nullptr
+ */
+shared_ptr<Histogram> Histogram::deserialize(const uint8_t *data, size_t size)
+{
+	if (size < 4 || !equal(HISTOGRAM_MAGIC, HISTOGRAM_MAGIC + 4, data))
+	{
+		return nullptr;
+	}
+	size_t pos = 4;
+	uint64_t numSymbols = 0;
+	size_t n = readVarint(data + pos, size - pos, numSymbols);
+	if (n == 0 || numSymbols < 1 || numSymbols > MAX_HISTOGRAM_SYMBOLS)
+	{
+		return nullptr;
+	}
+	pos += n;
+
+	shared_ptr<Histogram> histogram = make_shared<Histogram>((int)numSymbols);
+	uint64_t s = 0;
+	while (s < numSymbols)
+	{
+		n = readVarint(data + pos, size - pos, histogram->counts_[s]);
+		if (n == 0)
+		{
+			return nullptr;
+		}
+		pos += n;
+		s++;
+		if (histogram->counts_[s - 1] == 0)
+		{
+			uint64_t run = 0;
+			n = readVarint(data + pos, size - pos, run);
+			if (n == 0 || run > numSymbols - s)
+			{
+				return nullptr;
+			}
+			pos += n;
+			s += run;
+		}
+	}
+	if (pos != size)
+	{
+		return nullptr;
+	}
+	return histogram;
+}
+
+/**
+ * writeFile
+ * this function writes the histogram next to path and renames it into
+ * place, so a reader never opens a partly written file
+ * Preconditions: none
+ * Postconditions: writes the histogram to path, returns true on success
+ * @param path: histogram file name
+ * @return: true if the file was written
+ */
+bool Histogram::writeFile(const string &path) const
+{
+	vector<uint8_t> bytes;
+	serialize(bytes);
+	string temporary = path + ".tmp";
+	{
+		ofstream file(temporary, ios::binary);
+		file.write((const char *)bytes.data(), bytes.size());
+		file.close();
+		if (!file)
+		{
+			remove(temporary.c_str());
+			return false;
+		}
+	}
+	return rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * readFile
+ * Preconditions: none
+ * Postconditions: returns the histogram stored in path, or nullptr if
+ * it cannot be read
+ * @param path: histogram file name
+ * @return: the Histogram or nullptr
+ */
+shared_ptr<Histogram> Histogram::readFile(const string &path)
+{
+	ifstream file(path, ios::binary);
+	if (!file)
+	{
+		return nullptr;
+	}
+	vector<uint8_t> bytes((istreambuf_iterator<char>(file)),
+								 istreambuf_iterator<char>());
+	return deserialize(bytes.data(), bytes.size());
+}
@@ -0,0 +1,125 @@
+/*
+ * @file Histogram.h
+ * @author Katarina McGaughy
+ * Histogram class: The Histogram class holds symbol counts that can be
+ * computed in separate processes and added together later. Each worker
+ * counts its own shard and writes a small histogram file, and one
+ * process merges the files and builds the codebook, so the raw data
+ * never has to be sent to one place just to be counted.
+ *
+ * Features:
+ * -count bytes or add counts for any symbol
+ * -merge another histogram, in any order with the same result
+ * -serialize to and from bytes or a histogram file
+ * -files are written under a temporary name and renamed, so a process
+ *  reading a shared directory never sees half a file
+ *
+ * File format:
+ * -the 4 bytes "HHST"
+ * -number of symbols as a varint
+ * -each count as a varint. A 0 count is followed by a varint holding
+ *  how many more 0 counts come after it
+ *
+ * Assumptions:
+ * -histograms are only merged with histograms of the same alphabet
+ * -counts that would pass UINT64_MAX stay at UINT64_MAX, so adding is
+ *  still commutative and associative
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Dictionary.h"
+using namespace std;
+
+// largest alphabet a histogram file may hold
+const int MAX_HISTOGRAM_SYMBOLS = 1 << 16;
+
+class Histogram
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * Preconditions: numSymbols must be between 1 and
+	 * MAX_HISTOGRAM_SYMBOLS
+	 * Postconditions: Histogram with every count 0
+	 * @param numSymbols: number of symbols in the alphabet
+	 */
+	explicit Histogram(int numSymbols = NUM_BYTE_SYMBOLS);
+
+	/**
+	 * addBytes
+	 * Preconditions: every byte must be below size()
+	 * Postconditions: each byte value is counted once per occurrence
+	 * @param data: pointer to the bytes
+	 * @param size: number of bytes
+	 */
+	void addBytes(const uint8_t *data, size_t size);
+
+	/**
+	 * add
+	 * Preconditions: symbol must be below size()
+	 * Postconditions: count is added to the count of symbol
+	 * @param symbol: index of the symbol
+	 * @param count: amount to add
+	 */
+	void add(int symbol, uint64_t count = 1);
+
+	/**
+	 * merge
+	 * this function adds every count of other to this histogram
+	 * Preconditions: none
+	 * Postconditions: returns false and changes nothing if the alphabets
+	 * differ
+	 * @param other: Histogram to add
+	 * @return: true if the histograms were merged
+	 */
+	bool merge(const Histogram &other);
+
+	int size() const;
+	uint64_t getCount(int symbol) const;
+	const uint64_t *getCounts() const;
+	uint64_t getTotal() const;
+	bool operator==(const Histogram &other) const;
+
+	/**
+	 * serialize
+	 * Preconditions: none
+	 * Postconditions: the histogram file bytes are appended to out
+	 * @param out: vector the bytes are appended to
+	 */
+	void serialize(vector<uint8_t> &out) const;
+
+	/**
+	 * deserialize
+	 * Preconditions: none
+	 * Postconditions: returns the Histogram, or nullptr if the bytes are
+	 * not a valid histogram
+	 * @param data: pointer to the histogram bytes
+	 * @param size: number of bytes
+	 * @return: the Histogram or nullptr
+	 */
+	static shared_ptr<Histogram> deserialize(const uint8_t *data, size_t size);
+
+	/**
+	 * writeFile, readFile
+	 * Preconditions: none
+	 * Postconditions: write the histogram to path and return true on
+	 * success, or read it back and return nullptr on failure
+	 * @param path: histogram file name
+	 */
+	bool writeFile(const string &path) const;
+	static shared_ptr<Histogram> readFile(const string &path);
+
+private:
+	vector<uint64_t> counts_;
+};
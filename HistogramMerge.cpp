@@ -0,0 +1,139 @@
+/*
+ * @file HistogramMerge.cpp
+ * @author Katarina McGaughy
+ * HistogramMerge program: The HistogramMerge program builds one codebook
+ * from byte counts made by several worker processes. Each worker runs
+ * the count command on its own shard and writes a histogram file to a
+ * shared directory, then the merge command adds the files together and
+ * builds a Dictionary with HuffmanAlgorithm::buildCodeLengths.
+ *
+ * Usage:
+ * -HistogramMerge count <histogram file> <input file>...
+ *  counts the bytes of the input files into one histogram file
+ * -HistogramMerge merge <dictionary file> <id> <histogram file>...
+ *  merges the histogram files and writes the trained dictionary
+ *
+ * Assumptions:
+ * -histogram files hold byte counts, NUM_BYTE_SYMBOLS symbols
+ * -merging gives the same dictionary whatever order the files are in
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "DictionaryTrainer.h"
+#include "Histogram.h"
+using namespace std;
+
+/**
+ * count
+ * Preconditions: none
+ * Postconditions: writes the byte counts of the inputs to the histogram
+ * file, returns 0 on success
+ * @param histogramPath: histogram file to write
+ * @param inputs: files to count
+ * @return: exit status
+ */
+static int count(const string &histogramPath, const vector<string> &inputs)
+{
+	Histogram histogram;
+	for (const string &input : inputs)
+	{
+		ifstream file(input, ios::binary);
+		if (!file)
+		{
+			cerr << "cannot read " << input << endl;
+			return 1;
+		}
+		vector<uint8_t> bytes((istreambuf_iterator<char>(file)),
+									 istreambuf_iterator<char>());
+		histogram.addBytes(bytes.data(), bytes.size());
+	}
+	if (!histogram.writeFile(histogramPath))
+	{
+		cerr << "cannot write " << histogramPath << endl;
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * merge
+ * Preconditions: none
+ * Postconditions: writes the dictionary trained on the sum of the
+ * histograms, returns 0 on success
+ * @param dictionaryPath: dictionary file to write
+ * @param id: ID of the dictionary
+ * @param histograms: histogram files to merge
+ * @return: exit status
+ */
+static int merge(const string &dictionaryPath, uint32_t id,
+					  const vector<string> &histograms)
+{
+	Histogram total;
+	for (const string &path : histograms)
+	{
+		shared_ptr<Histogram> histogram = Histogram::readFile(path);
+		if (!histogram || !total.merge(*histogram))
+		{
+			cerr << "not a byte histogram: " << path << endl;
+			return 1;
+		}
+	}
+
+	DictionaryTrainer trainer;
+	if (!trainer.addHistogram(total))
+	{
+		cerr << "not a byte histogram" << endl;
+		return 1;
+	}
+	shared_ptr<const Dictionary> dictionary = trainer.train(id);
+	if (!dictionary->writeFile(dictionaryPath))
+	{
+		cerr << "cannot write " << dictionaryPath << endl;
+		return 1;
+	}
+
+	uint64_t bits = 0;
+	for (int s = 0; s < NUM_BYTE_SYMBOLS; s++)
+	{
+		bits += total.getCount(s) * dictionary->getLength(s);
+	}
+	cout << "merged " << histograms.size() << " histograms, "
+		  << total.getTotal() << " bytes, " << bits / 8 << " bytes coded"
+		  << endl;
+	return 0;
+}
+
+/**
+ * main
+ * Preconditions: none
+ * Postconditions: runs the count or merge command
+ */
+int main(int argc, char *argv[])
+{
+	vector<string> args(argv + 1, argv + argc);
+	if (args.size() >= 3 && args[0] == "count")
+	{
+		return count(args[1], vector<string>(args.begin() + 2, args.end()));
+	}
+	if (args.size() >= 4 && args[0] == "merge")
+	{
+		return merge(args[1], (uint32_t)strtoul(args[2].c_str(), nullptr, 10),
+						 vector<string>(args.begin() + 3, args.end()));
+	}
+	cerr << "usage: HistogramMerge count <histogram file> <input file>..."
+		  << endl
+		  << "       HistogramMerge merge <dictionary file> <id> "
+			  "<histogram file>..."
+		  << endl;
+	return 2;
+}
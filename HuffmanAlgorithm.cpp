@@ -25,6 +25,9 @@
  *
  */
 #include "HuffmanAlgorithm.h"
+#include <algorithm>
+#include <queue>
+#include <utility>
 
 //divide this function into smaller functions
 
@@ -40,9 +43,41 @@
  * PreConditions: an integer array with length of 26 must be initialized
  * PostConditions: the CodeBook is filled with Huffman codes based on the integer
  * array passed in
+ * @param counts: 64 bit frequencies for each lowercase letter
+ */
+HuffmanAlgorithm::HuffmanAlgorithm(const uint64_t (&counts)[NUM_LETTERS])
+{
+	build(counts);
+}
+
+/**
+ * Overloaded constructor
+ * this function widens int counts to 64 bits, treating negative
+ * counts as 0, and builds the CodeBook the same way
+ * PreConditions: an integer array with length of 26 must be initialized
+ * PostConditions: the CodeBook is filled with Huffman codes based on the
+ * integer array passed in
  * @param counts: integer array of frequencies for each lowercase number
  */
 HuffmanAlgorithm::HuffmanAlgorithm(int (&counts)[NUM_LETTERS])
+{
+	uint64_t wide[NUM_LETTERS];
+	for (int i = 0; i < NUM_LETTERS; i++)
+	{
+		wide[i] = counts[i] < 0 ? 0 : counts[i];
+	}
+	build(wide);
+}
+
+/**
+ * build
+ * this function builds the trees, merges them and fills the
+ * CodeBook, for both constructors
+ * PreConditions: counts must have 26 entries
+ * PostConditions: the CodeBook and table are filled
+ * @param counts: 64 bit frequencies for each lowercase letter
+ */
+void HuffmanAlgorithm::build(const uint64_t counts[])
 {
 	// initialize all huffman tree for each letter of alphabet
 	string alphabet = "abcdefghijklmnopqrstuvwxyz";
@@ -86,6 +121,8 @@ HuffmanAlgorithm::HuffmanAlgorithm(int (&counts)[NUM_LETTERS])
 	HuffmanTree finalTree = HuffmanTree(*pq.items[1]);
 	finalTree.generateCodeBook(CodeBook);
 
+	table = make_shared<const CodeTable>(CodeBook, NUM_LETTERS);
+
 	if (finalTree1 == finalTree){
 		cout << "assignment operator works" << endl;
 	}
@@ -116,22 +153,310 @@ HuffmanAlgorithm::HuffmanAlgorithm(int (&counts)[NUM_LETTERS])
  * @return: the code for the string entered based on Huffman
  * coding
  */
-string HuffmanAlgorithm::getWord(string in)
+string HuffmanAlgorithm::getWord(string in) const
 {
-	string code = "";
-	string alphabet = "abcdefghijklmnopqrstuvwxyz";
-	int length = in.length();
-	for (int i = 0; i < length; i++)
+	return table->getWord(in);
+}
+
+/**
+ * decode
+ * this function takes in a string of 0s and 1s produced by getWord
+ * and walks the decode table to recover the letters
+ * Preconditions: CodeBook must be filled
+ * PostConditions: returns the letters for the code entered, stopping
+ * at the last complete code
+ * @param bits: string of 0s and 1s
+ * @return: the decoded letters
+ */
+string HuffmanAlgorithm::decode(const string &bits) const
+{
+	return table->decode(bits);
+}
+
+/**
+ * getCodeTable
+ * this function returns the immutable encode and decode tables,
+ * which can be shared with other threads or published through a
+ * SharedCodeTable
+ * Preconditions: CodeBook must be filled
+ * PostConditions: returns the CodeTable for this CodeBook
+ * @return: shared pointer to the CodeTable
+ */
+shared_ptr<const CodeTable> HuffmanAlgorithm::getCodeTable() const
+{
+	return table;
+}
+
+/**
+ * getCodeLengths
+ * this function stores the length of the code for each letter
+ * Preconditions: lengths must have length 26
+ * PostConditions: lengths holds the code length of each letter
+ * @param lengths: integer array of code lengths
+ */
+void HuffmanAlgorithm::getCodeLengths(int lengths[]) const
+{
+	for (int i = 0; i < NUM_LETTERS; i++)
+	{
+		lengths[i] = CodeBook[i].length();
+	}
+}
+
+/**
+ * buildCodeLengths
+ * this function builds a HuffmanTree for each symbol with a nonzero
+ * count, merges them through a heap and stores the code length of
+ * each symbol, for an alphabet of any size. Lengths are then limited
+ * to maxLength
+ * PreConditions: counts and lengths must have numSymbols entries, at
+ * most 2^maxLength counts may be nonzero
+ * PostConditions: lengths holds the code length of each symbol, 0 for
+ * symbols with a count of 0
+ * @param counts: 64 bit frequencies for each symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param maxLength: longest code length allowed
+ * @param lengths: integer array of code lengths
+ */
+void HuffmanAlgorithm::buildCodeLengths(const uint64_t counts[], int numSymbols,
+													 int maxLength, int lengths[])
+{
+	// only symbols that occur get a tree
+	vector<HuffmanTree *> trees;
+	for (int i = 0; i < numSymbols; i++)
+	{
+		lengths[i] = 0;
+		if (counts[i] > 0)
+		{
+			trees.push_back(new HuffmanTree(i, counts[i]));
+		}
+	}
+	if (trees.empty())
+	{
+		return;
+	}
+
+	// merge the two min trees until one is left. A local heap of
+	// pointers owns the trees, so each one is deleted exactly once
+	auto greater = [](const HuffmanTree *a, const HuffmanTree *b)
+	{ return *b < *a; };
+	priority_queue<HuffmanTree *, vector<HuffmanTree *>, decltype(greater)>
+		 pq(greater, move(trees));
+	while (pq.size() > 1)
+	{
+		HuffmanTree *firstTree = pq.top();
+		pq.pop();
+		HuffmanTree *secondTree = pq.top();
+		pq.pop();
+		pq.push(new HuffmanTree(*firstTree, *secondTree));
+		delete firstTree;
+		delete secondTree;
+	}
+	HuffmanTree *root = pq.top();
+	root->generateCodeLengths(lengths);
+	delete root;
+	limitCodeLengths(counts, numSymbols, maxLength, lengths);
+}
+
+/**
+ * buildCodeLengthsSorted
+ * this function builds the same kind of code lengths as
+ * buildCodeLengths for alphabets of millions of symbols, such as
+ * token vocabularies. The symbols are sorted by count once, and since
+ * merged nodes are created in order of weight, a queue of leaves and
+ * a queue of merged nodes replace the PriorityQueue and HuffmanTree
+ * objects. Lengths are limited with one bucket per length, so each
+ * step is constant time
+ * PreConditions: counts and lengths must have numSymbols entries,
+ * maxLength must be at most 32, at most 2^maxLength counts may be
+ * nonzero
+ * PostConditions: lengths holds the code length of each symbol, 0 for
+ * symbols with a count of 0
+ * @param counts: 64 bit frequencies for each symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param maxLength: longest code length allowed
+ * @param lengths: integer array of code lengths
+ */
+void HuffmanAlgorithm::buildCodeLengthsSorted(const uint64_t counts[],
+															 int numSymbols, int maxLength,
+															 int lengths[])
+{
+	// leaves from least to most frequent, ties by symbol
+	vector<int> order;
+	for (int i = 0; i < numSymbols; i++)
 	{
-		for (int j = 0; j < NUM_LETTERS; j++)
+		lengths[i] = 0;
+		if (counts[i] > 0)
 		{
-			if (in[i] == alphabet[j])
+			order.push_back(i);
+		}
+	}
+	if (order.empty())
+	{
+		return;
+	}
+	if (order.size() == 1)
+	{
+		lengths[order[0]] = 1;
+		return;
+	}
+	sort(order.begin(), order.end(), [counts](int a, int b)
+		  { return counts[a] < counts[b] || (counts[a] == counts[b] && a < b); });
+
+	// nodes 0 to n - 1 are the sorted leaves, n + m is the m-th merge
+	size_t n = order.size();
+	vector<uint64_t> merged(n - 1);
+	vector<size_t> parent(2 * n - 1, 0);
+	size_t leaf = 0;
+	size_t next = 0;
+	for (size_t m = 0; m < n - 1; m++)
+	{
+		size_t pick[2];
+		uint64_t weight = 0;
+		for (int k = 0; k < 2; k++)
+		{
+			if (leaf < n && (next == m || counts[order[leaf]] <= merged[next]))
+			{
+				weight += counts[order[leaf]];
+				pick[k] = leaf++;
+			}
+			else
 			{
-				code = code + CodeBook[j];
+				weight += merged[next];
+				pick[k] = n + next++;
 			}
 		}
+		merged[m] = weight;
+		parent[pick[0]] = n + m;
+		parent[pick[1]] = n + m;
+	}
+
+	// the last merge is the root, parents always come after children
+	vector<int> depth(2 * n - 1, 0);
+	for (size_t j = 2 * n - 2; j-- > 0;)
+	{
+		depth[j] = depth[parent[j]] + 1;
+	}
+
+	// clamp, and bucket by length with the least frequent at the back
+	const uint64_t one = (uint64_t)1 << maxLength;
+	uint64_t kraft = 0;
+	vector<vector<int>> bucket(maxLength + 1);
+	for (size_t i = n; i-- > 0;)
+	{
+		int length = depth[i] < maxLength ? depth[i] : maxLength;
+		lengths[order[i]] = length;
+		kraft += one >> length;
+		bucket[length].push_back(order[i]);
+	}
+
+	// lengthen the least frequent of the longest codes below maxLength
+	// until the lengths form a prefix code, as limitCodeLengths does
+	int longest = maxLength - 1;
+	while (kraft > one)
+	{
+		while (bucket[longest].empty())
+		{
+			longest--;
+		}
+		int pick = bucket[longest].back();
+		bucket[longest].pop_back();
+		lengths[pick]++;
+		kraft -= one >> lengths[pick];
+		if (lengths[pick] < maxLength)
+		{
+			bucket[lengths[pick]].push_back(pick);
+			longest = lengths[pick];
+		}
+	}
+}
+
+/**
+ * normalizeCounts
+ * this function scales counts so they add up to exactly total,
+ * keeping every nonzero count at 1 or more. The result only depends
+ * on the proportions of the counts, so histograms of different
+ * sizes with the same shape give the same codebook, and integer
+ * arithmetic makes it the same on every machine
+ * PreConditions: counts and normalized must have numSymbols entries,
+ * the counts must add up to less than 2^64
+ * PostConditions: returns false, leaving normalized unchanged, if
+ * every count is 0, total is above MAX_NORMALIZED_TOTAL or total is
+ * less than the number of nonzero counts
+ * @param counts: 64 bit frequencies for each symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param total: sum the counts are scaled to
+ * @param normalized: scaled frequencies for each symbol
+ * @return: true if the counts were scaled
+ */
+bool HuffmanAlgorithm::normalizeCounts(const uint64_t counts[], int numSymbols,
+													uint64_t total, uint64_t normalized[])
+{
+	uint64_t sum = 0;
+	uint64_t nonzero = 0;
+	int largest = -1;
+	for (int i = 0; i < numSymbols; i++)
+	{
+		sum += counts[i];
+		if (counts[i] > 0)
+		{
+			nonzero++;
+			if (largest < 0 || counts[i] > counts[largest])
+			{
+				largest = i;
+			}
+		}
+	}
+	if (nonzero == 0 || total > MAX_NORMALIZED_TOTAL || total < nonzero)
+	{
+		return false;
+	}
+
+	// drop low bits until count * total fits in 64 bits
+	int shift = 0;
+	while ((sum >> shift) >= MAX_NORMALIZED_TOTAL)
+	{
+		shift++;
+	}
+	uint64_t reducedSum = 0;
+	for (int i = 0; i < numSymbols; i++)
+	{
+		reducedSum += counts[i] >> shift;
+	}
+
+	// round down, but never drop a symbol that occurs
+	uint64_t scaledSum = 0;
+	for (int i = 0; i < numSymbols; i++)
+	{
+		normalized[i] = 0;
+		if (counts[i] > 0)
+		{
+			normalized[i] = (counts[i] >> shift) * total / reducedSum;
+			if (normalized[i] == 0)
+			{
+				normalized[i] = 1;
+			}
+			scaledSum += normalized[i];
+		}
+	}
+
+	// rounding down leaves a shortfall for the most frequent symbol,
+	// raising counts to 1 can leave an excess to take from the largest
+	if (scaledSum <= total)
+	{
+		normalized[largest] += total - scaledSum;
+		return true;
+	}
+	uint64_t excess = scaledSum - total;
+	for (int i = largest; excess > 0; i = (i + 1) % numSymbols)
+	{
+		if (normalized[i] > 1)
+		{
+			uint64_t take = normalized[i] - 1 < excess ? normalized[i] - 1 : excess;
+			normalized[i] -= take;
+			excess -= take;
+		}
 	}
-	return code;
+	return true;
 }
 
 /**
@@ -25,20 +25,40 @@
  *
  */
 
+#include <cstdint>
 #include <string>
+#include <memory>
+#include <vector>
 #include <iostream>
+#include "CodeTable.h"
 #include "HuffmanTree.h"
 #include "PriorityQueue.h"
 using namespace std;
 #pragma once
 const int NUM_LETTERS = 26;
 
+// largest total normalizeCounts can scale to
+const uint64_t MAX_NORMALIZED_TOTAL = (uint64_t)1 << 32;
+
 class HuffmanAlgorithm
 {
 private:
 	// stores codes for each character
 	string CodeBook[NUM_LETTERS];
 
+	// immutable encode and decode tables built from the CodeBook
+	shared_ptr<const CodeTable> table;
+
+	/**
+	 * build
+	 * this function builds the trees, merges them and fills the
+	 * CodeBook, for both constructors
+	 * PreConditions: counts must have 26 entries
+	 * PostConditions: the CodeBook and table are filled
+	 * @param counts: 64 bit frequencies for each lowercase letter
+	 */
+	void build(const uint64_t counts[]);
+
 public:
 	/**
 	 * desctructor
@@ -60,6 +80,17 @@ public:
 	 * PreConditions: an integer array with length of 26 must be initialized
 	 * PostConditions: the CodeBook is filled with Huffman codes based on the 
 	 * integer array passed in
+	 * @param counts: 64 bit frequencies for each lowercase letter
+	 */
+	HuffmanAlgorithm(const uint64_t (&counts)[NUM_LETTERS]);
+
+	/**
+	 * Overloaded constructor
+	 * this function widens int counts to 64 bits, treating negative
+	 * counts as 0, and builds the CodeBook the same way
+	 * PreConditions: an integer array with length of 26 must be initialized
+	 * PostConditions: the CodeBook is filled with Huffman codes based on the
+	 * integer array passed in
 	 * @param counts: integer array of frequencies for each lowercase number
 	 */
 	HuffmanAlgorithm(int (&counts)[NUM_LETTERS]);
@@ -73,7 +104,117 @@ public:
 	 * @return: the code for the string entered based on Huffman
 	 * coding
 	 */
-	string getWord(string in);
+	string getWord(string in) const;
+
+	/**
+	 * decode
+	 * this function takes in a string of 0s and 1s produced by getWord
+	 * and walks the decode table to recover the letters
+	 * Preconditions: CodeBook must be filled
+	 * PostConditions: returns the letters for the code entered, stopping
+	 * at the last complete code
+	 * @param bits: string of 0s and 1s
+	 * @return: the decoded letters
+	 */
+	string decode(const string &bits) const;
+
+	/**
+	 * getCodeTable
+	 * this function returns the immutable encode and decode tables,
+	 * which can be shared with other threads or published through a
+	 * SharedCodeTable
+	 * Preconditions: CodeBook must be filled
+	 * PostConditions: returns the CodeTable for this CodeBook
+	 * @return: shared pointer to the CodeTable
+	 */
+	shared_ptr<const CodeTable> getCodeTable() const;
+
+	/**
+	 * getCodeLengths
+	 * this function stores the length of the code for each letter
+	 * Preconditions: lengths must have length 26
+	 * PostConditions: lengths holds the code length of each letter
+	 * @param lengths: integer array of code lengths
+	 */
+	void getCodeLengths(int lengths[]) const;
+
+	/**
+	 * buildCodeLengths
+	 * this function builds a HuffmanTree for each symbol with a nonzero
+	 * count, merges them through a heap and stores the code length of
+	 * each symbol, for an alphabet of any size. Lengths are then limited
+	 * to maxLength
+	 * PreConditions: counts and lengths must have numSymbols entries, at
+	 * most 2^maxLength counts may be nonzero
+	 * PostConditions: lengths holds the code length of each symbol, 0 for
+	 * symbols with a count of 0
+	 * @param counts: 64 bit frequencies for each symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param maxLength: longest code length allowed
+	 * @param lengths: integer array of code lengths
+	 */
+	static void buildCodeLengths(const uint64_t counts[], int numSymbols,
+										  int maxLength, int lengths[]);
+
+	/**
+	 * buildCodeLengthsSorted
+	 * this function builds the same kind of code lengths as
+	 * buildCodeLengths for alphabets of millions of symbols, such as
+	 * token vocabularies. The symbols are sorted by count once, and since
+	 * merged nodes are created in order of weight, a queue of leaves and
+	 * a queue of merged nodes replace the PriorityQueue and HuffmanTree
+	 * objects. Lengths are limited with one bucket per length, so each
+	 * step is constant time
+	 * PreConditions: counts and lengths must have numSymbols entries,
+	 * maxLength must be at most 32, at most 2^maxLength counts may be
+	 * nonzero
+	 * PostConditions: lengths holds the code length of each symbol, 0 for
+	 * symbols with a count of 0
+	 * @param counts: 64 bit frequencies for each symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param maxLength: longest code length allowed
+	 * @param lengths: integer array of code lengths
+	 */
+	static void buildCodeLengthsSorted(const uint64_t counts[], int numSymbols,
+												  int maxLength, int lengths[]);
+
+	/**
+	 * normalizeCounts
+	 * this function scales counts so they add up to exactly total,
+	 * keeping every nonzero count at 1 or more. The result only depends
+	 * on the proportions of the counts, so histograms of different
+	 * sizes with the same shape give the same codebook, and integer
+	 * arithmetic makes it the same on every machine
+	 * PreConditions: counts and normalized must have numSymbols entries,
+	 * the counts must add up to less than 2^64
+	 * PostConditions: returns false, leaving normalized unchanged, if
+	 * every count is 0, total is above MAX_NORMALIZED_TOTAL or total is
+	 * less than the number of nonzero counts
+	 * @param counts: 64 bit frequencies for each symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param total: sum the counts are scaled to
+	 * @param normalized: scaled frequencies for each symbol
+	 * @return: true if the counts were scaled
+	 */
+	static bool normalizeCounts(const uint64_t counts[], int numSymbols,
+										 uint64_t total, uint64_t normalized[]);
+
+	/**
+	 * limitCodeLengths
+	 * this function shortens codes longer than maxLength to maxLength
+	 * and then lengthens the longest codes that are still shorter than
+	 * maxLength, least frequent first, until the lengths form a valid
+	 * prefix code again
+	 * PreConditions: at most 2^maxLength lengths may be nonzero
+	 * PostConditions: no length is greater than maxLength
+	 * @param counts: 64 bit frequencies for each symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 * @param maxLength: longest code length allowed
+	 * @param lengths: integer array of code lengths
+	 */
+	static constexpr void limitCodeLengths(const uint64_t counts[],
+														int numSymbols, int maxLength,
+														int lengths[]);
 
 	/**
 	 * Overloaded output operator for HuffmanAlgorithm
@@ -87,3 +228,56 @@ public:
 	 */
 	friend ostream &operator<<(ostream &os, const HuffmanAlgorithm &algo);
 };
+
+/**
+ * limitCodeLengths
+ * this function shortens codes longer than maxLength to maxLength
+ * and then lengthens the longest codes that are still shorter than
+ * maxLength, least frequent first, until the lengths form a valid
+ * prefix code again
+ * PreConditions: at most 2^maxLength lengths may be nonzero
+ * PostConditions: no length is greater than maxLength
+ * (constexpr so StaticCodebook can use it at compile time)
+ * @param counts: 64 bit frequencies for each symbol
+ * @param numSymbols: number of symbols in the alphabet
+ * @param maxLength: longest code length allowed
+ * @param lengths: integer array of code lengths
+ */
+constexpr void HuffmanAlgorithm::limitCodeLengths(const uint64_t counts[],
+																  int numSymbols,
+																  int maxLength,
+																  int lengths[])
+{
+	// Kraft sum in units of 2^-maxLength, a prefix code needs at most 1
+	const int64_t one = (int64_t)1 << maxLength;
+	int64_t kraft = 0;
+	for (int i = 0; i < numSymbols; i++)
+	{
+		if (lengths[i] > maxLength)
+		{
+			lengths[i] = maxLength;
+		}
+		if (lengths[i] > 0)
+		{
+			kraft += one >> lengths[i];
+		}
+	}
+
+	while (kraft > one)
+	{
+		// longest code below maxLength, least frequent on ties
+		int pick = -1;
+		for (int i = 0; i < numSymbols; i++)
+		{
+			if (lengths[i] > 0 && lengths[i] < maxLength &&
+				 (pick < 0 || lengths[i] > lengths[pick] ||
+				  (lengths[i] == lengths[pick] && counts[i] < counts[pick])))
+			{
+				pick = i;
+			}
+		}
+		// one more bit halves the share of the code space it takes
+		lengths[pick]++;
+		kraft -= one >> lengths[pick];
+	}
+}
@@ -44,12 +44,30 @@ HuffmanTree::HuffmanTree()
  * Postconditios: new HuffmanTree is initialized with newData for data,
  * count for weight, and newData with minChar
  */
-HuffmanTree::HuffmanTree(char newData, int count)
+HuffmanTree::HuffmanTree(char newData, uint64_t count)
 {
 	root_ = new Node();
 	root_->data = newData;
 	root_->weight = count;
 	root_->minChar = newData;
+	root_->symbol = newData - 'a';
+}
+
+/**
+ * Overloaded constructor
+ * this function initializes a single leaf HuffmanTree for the symbol
+ * with the given index, for alphabets other than lowercase letters
+ * Preconditions: symbol must not be negative
+ * Postconditios: new HuffmanTree is initialized with symbol and
+ * count for weight
+ * @param symbol: index of the symbol in its alphabet
+ * @param count: frequency of the symbol
+ */
+HuffmanTree::HuffmanTree(int symbol, uint64_t count)
+{
+	root_ = new Node();
+	root_->weight = count;
+	root_->symbol = symbol;
 }
 
 /**
@@ -202,6 +220,7 @@ void HuffmanTree::copyHelper(Node *copyRoot, Node *&thisRoot)
 		thisRoot->data = copyRoot->data;
 		thisRoot->weight = copyRoot->weight;
 		thisRoot->minChar = copyRoot->minChar;
+		thisRoot->symbol = copyRoot->symbol;
 		copyHelper(copyRoot->leftChild, thisRoot->leftChild);
 		copyHelper(copyRoot->rightChild, thisRoot->rightChild);
 	}
@@ -235,7 +254,6 @@ bool HuffmanTree::operator<(const HuffmanTree &rhs) const
 	// if weights are equal then compare characters
 	if (root_->weight == rhs.root_->weight)
 	{
-		cout << "Weights are equal" << endl;
 		// traverse tree and find smallest character in both
 		if (root_->minChar < rhs.root_->minChar)
 		{
@@ -455,3 +473,50 @@ void HuffmanTree::generateCodeBookHelper(Node *root, char c,
 	generateCodeBookHelper(root->leftChild, c, codeBook, pos, code + "0");
 	generateCodeBookHelper(root->rightChild, c, codeBook, pos, code + "1");
 }
+
+/**
+ * generateCodeLengths
+ * this function traverses the tree once and stores the code length
+ * (depth) of every leaf symbol in the lengths array. A tree with a
+ * single leaf gives that symbol a length of 1
+ * @PreCondition: lengths must have room for every symbol in the tree
+ * @PostConditons: lengths holds the code length of each leaf symbol,
+ * entries for symbols not in the tree are left unchanged
+ * @param lengths: integer array of code lengths
+ */
+void HuffmanTree::generateCodeLengths(int lengths[]) const
+{
+	if (root_ != nullptr && root_->leftChild == nullptr &&
+		 root_->rightChild == nullptr)
+	{
+		lengths[root_->symbol] = 1;
+		return;
+	}
+	generateCodeLengthsHelper(root_, 0, lengths);
+}
+
+/**
+ * generateCodeLengthsHelper
+ * this function recursively traverses the tree once and stores the
+ * depth of every leaf as the code length of its symbol
+ * @PreCondition: lengths must have room for every symbol in the tree
+ * @PostConditons: lengths holds the code length of each leaf symbol
+ * @param root: pointer to the current Node
+ * @param depth: depth of root in the tree
+ * @param lengths: integer array of code lengths
+ */
+void HuffmanTree::generateCodeLengthsHelper(Node *root, int depth,
+														  int lengths[]) const
+{
+	if (root == nullptr)
+	{
+		return;
+	}
+	if (root->leftChild == nullptr && root->rightChild == nullptr)
+	{
+		lengths[root->symbol] = depth;
+		return;
+	}
+	generateCodeLengthsHelper(root->leftChild, depth + 1, lengths);
+	generateCodeLengthsHelper(root->rightChild, depth + 1, lengths);
+}
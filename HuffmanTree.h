@@ -23,6 +23,7 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <iostream>
 #include <string>
 using namespace std;
@@ -46,7 +47,8 @@ private:
 	 * Node struct contains a char (data), a pointer to
 	 * right child node (rightChild,) and left child node (leftChild),
 	 * a count for the frequency of the char (weight),
-	 * and a char (minChar) storing the minimum char in tree
+	 * a char (minChar) storing the minimum char in tree,
+	 * and the index of the symbol stored in a leaf (symbol)
 	 */
 	struct Node
 	{
@@ -60,11 +62,15 @@ private:
 		// pointer to left child
 		Node *leftChild = nullptr;
 
-		// weight based on frequency of character
-		int weight = -1;
+		// weight based on frequency of character, 64 bits so counts
+		// and merged totals over 2^31 keep the heap in order
+		uint64_t weight = 0;
 
 		// minimum char in tree
 		char minChar = '\n';
+
+		// index of the symbol in its alphabet, -1 for merged nodes
+		int symbol = -1;
 	};
 
 	// pointer to root of HuffmanTree
@@ -142,6 +148,18 @@ private:
 	void generateCodeBookHelper(Node *root, char c, string codeBook[],
 										 int pos, string code) const;
 
+	/**
+	 * generateCodeLengthsHelper
+	 * this function recursively traverses the tree once and stores the
+	 * depth of every leaf as the code length of its symbol
+	 * @PreCondition: lengths must have room for every symbol in the tree
+	 * @PostConditons: lengths holds the code length of each leaf symbol
+	 * @param root: pointer to the current Node
+	 * @param depth: depth of root in the tree
+	 * @param lengths: integer array of code lengths
+	 */
+	void generateCodeLengthsHelper(Node *root, int depth, int lengths[]) const;
+
 	/**
 	 * determinMinChar
 	 * this functions takes in two characters and returns
@@ -174,7 +192,19 @@ public:
 	 * Postconditios: new HuffmanTree is initialized with newData for data,
 	 * count for weight, and newData with minChar
 	 */
-	HuffmanTree(char newData, int count);
+	HuffmanTree(char newData, uint64_t count);
+
+	/**
+	 * Overloaded constructor
+	 * this function initializes a single leaf HuffmanTree for the symbol
+	 * with the given index, for alphabets other than lowercase letters
+	 * Preconditions: symbol must not be negative
+	 * Postconditios: new HuffmanTree is initialized with symbol and
+	 * count for weight
+	 * @param symbol: index of the symbol in its alphabet
+	 * @param count: frequency of the symbol
+	 */
+	HuffmanTree(int symbol, uint64_t count);
 
 	/**
 	 * copy constructor
@@ -280,4 +310,16 @@ public:
 	 * @param codeBook: string array
 	 */
 	void generateCodeBook(string codeBook[]) const;
+
+	/**
+	 * generateCodeLengths
+	 * this function traverses the tree once and stores the code length
+	 * (depth) of every leaf symbol in the lengths array. A tree with a
+	 * single leaf gives that symbol a length of 1
+	 * @PreCondition: lengths must have room for every symbol in the tree
+	 * @PostConditons: lengths holds the code length of each leaf symbol,
+	 * entries for symbols not in the tree are left unchanged
+	 * @param lengths: integer array of code lengths
+	 */
+	void generateCodeLengths(int lengths[]) const;
 };
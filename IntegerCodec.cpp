@@ -0,0 +1,248 @@
+/*
+ * @file IntegerCodec.cpp
+ * @author Katarina McGaughy
+ * IntegerCodec class: The IntegerCodec class compresses arrays of
+ * integers, such as deltas, IDs and timestamps, that do not fit a 26 or
+ * 256 symbol alphabet. Each value is split into a bucket symbol and raw
+ * extra bits. Small values are their own bucket, and larger values are
+ * bucketed by their bit length and the bit below the leading 1, so the
+ * buckets grow on a log scale and only the bucket carries the skew of
+ * the data. The buckets are Huffman coded with code lengths from
+ * HuffmanAlgorithm::buildCodeLengths, and the extra bits are written
+ * right after each code.
+ *
+ * Features:
+ * -encode and decode arrays of uint32_t or uint64_t
+ * -INTEGER_DIRECT_VALUES values coded by bucket alone, 2 buckets per
+ *  bit length above them
+ * -codebook stored as a CodebookHeader
+ *
+ * Format:
+ * -number of values as a varint
+ * -if there are any values, a CodebookHeader for the bucket symbols,
+ *  then each bucket code followed by its extra bits, most significant
+ *  first, padded to a whole byte
+ *
+ * Assumptions:
+ * -a stream written from uint64_t values is decoded as uint64_t, and
+ *  decoding it as uint32_t fails if a value does not fit
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "IntegerCodec.h"
+#include <bit>
+#include <limits>
+#include "BitStream.h"
+#include "CodeTable.h"
+#include "CodebookHeader.h"
+#include "Varint.h"
+
+// bit length of the first value that is not a direct value
+static const int FIRST_BUCKET_LENGTH = 5;
+
+/**
+ * bucketBase
+ * Preconditions: symbol must be below NUM_INTEGER_BUCKETS
+ * Postconditions: returns the smallest value in the bucket and sets
+ * extraBits to the number of raw bits that follow its code
+ */
+static uint64_t bucketBase(int symbol, int &extraBits)
+{
+	if (symbol < INTEGER_DIRECT_VALUES)
+	{
+		extraBits = 0;
+		return symbol;
+	}
+	int length = (symbol - INTEGER_DIRECT_VALUES) / 2 + FIRST_BUCKET_LENGTH;
+	extraBits = length - 2;
+	return (uint64_t)(2 + (symbol - INTEGER_DIRECT_VALUES) % 2) << extraBits;
+}
+
+/**
+ * encode
+ * this function counts the buckets of the values, builds their
+ * codebook and appends the coded values to out
+ * Preconditions: none
+ * Postconditions: the coded values are appended to out
+ * @param values: pointer to the values
+ * @param count: number of values
+ * @param out: vector the bytes are appended to
+ */
+void IntegerCodec::encode(const uint32_t *values, size_t count,
+								  vector<uint8_t> &out)
+{
+	encodeValues(values, count, out);
+}
+
+void IntegerCodec::encode(const uint64_t *values, size_t count,
+								  vector<uint8_t> &out)
+{
+	encodeValues(values, count, out);
+}
+
+/**
+ * decode
+ * this function reads coded values and appends them to out
+ * Preconditions: none
+ * Postconditions: returns the number of bytes read, or 0 if the
+ * data is malformed, ends early or, for uint32_t, holds a value that
+ * does not fit
+ * @param data: pointer to the coded values
+ * @param size: number of bytes available
+ * @param out: vector the values are appended to
+ * @return: number of bytes read, 0 on error
+ */
+size_t IntegerCodec::decode(const uint8_t *data, size_t size,
+									 vector<uint32_t> &out)
+{
+	return decodeValues(data, size, out);
+}
+
+size_t IntegerCodec::decode(const uint8_t *data, size_t size,
+									 vector<uint64_t> &out)
+{
+	return decodeValues(data, size, out);
+}
+
+/**
+ * bucketOf
+ * Preconditions: none
+ * Postconditions: returns the bucket symbol of value and sets
+ * extraBits to the number of raw bits that follow its code
+ * @param value: integer to bucket
+ * @param extraBits: set to the number of extra bits
+ * @return: bucket symbol below NUM_INTEGER_BUCKETS
+ */
+int IntegerCodec::bucketOf(uint64_t value, int &extraBits)
+{
+	if (value < INTEGER_DIRECT_VALUES)
+	{
+		extraBits = 0;
+		return (int)value;
+	}
+	// the leading 1 and the bit below it pick the bucket, the rest are
+	// extra bits
+	int length = bit_width(value);
+	extraBits = length - 2;
+	int second = (value >> extraBits) & 1;
+	return INTEGER_DIRECT_VALUES + 2 * (length - FIRST_BUCKET_LENGTH) + second;
+}
+
+/**
+ * encodeValues
+ * this function writes the count, the codebook built from the bucket
+ * counts, then each bucket code and its extra bits
+ * Preconditions: none
+ * Postconditions: the coded values are appended to out
+ */
+template <typename T>
+void IntegerCodec::encodeValues(const T *values, size_t count,
+										  vector<uint8_t> &out)
+{
+	writeVarint(count, out);
+	if (count == 0)
+	{
+		return;
+	}
+
+	uint64_t counts[NUM_INTEGER_BUCKETS] = {};
+	vector<uint8_t> buckets(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		int extraBits = 0;
+		buckets[i] = (uint8_t)bucketOf(values[i], extraBits);
+		counts[buckets[i]]++;
+	}
+	int lengths[NUM_INTEGER_BUCKETS];
+	CodebookHeader::fromCounts(counts, NUM_INTEGER_BUCKETS, lengths, out);
+	shared_ptr<const CodeTable> table =
+		 CodeTable::fromLengths(lengths, NUM_INTEGER_BUCKETS, 0);
+
+	BitWriter writer(out);
+	for (size_t i = 0; i < count; i++)
+	{
+		table->encodeSymbol(buckets[i], writer);
+		int extraBits = 0;
+		bucketBase(buckets[i], extraBits);
+		// up to 62 extra bits, more than one write can take
+		if (extraBits > MAX_BITS_PER_CALL)
+		{
+			writer.write((uint64_t)values[i] >> MAX_BITS_PER_CALL,
+							 extraBits - MAX_BITS_PER_CALL);
+			extraBits = MAX_BITS_PER_CALL;
+		}
+		writer.write(values[i], extraBits);
+	}
+	writer.flush();
+}
+
+/**
+ * decodeValues
+ * this function reads the count and codebook, then decodes each bucket
+ * and adds its extra bits
+ * Preconditions: none
+ * Postconditions: returns the number of bytes read, or 0 on error
+ */
+template <typename T>
+size_t IntegerCodec::decodeValues(const uint8_t *data, size_t size,
+											 vector<T> &out)
+{
+	uint64_t count = 0;
+	size_t pos = readVarint(data, size, count);
+	if (pos == 0)
+	{
+		return 0;
+	}
+	if (count == 0)
+	{
+		return pos;
+	}
+
+	int lengths[NUM_INTEGER_BUCKETS];
+	int numSymbols = 0;
+	size_t used = CodebookHeader::read(data + pos, size - pos, lengths,
+												  NUM_INTEGER_BUCKETS, numSymbols);
+	if (used == 0)
+	{
+		return 0;
+	}
+	pos += used;
+	shared_ptr<const CodeTable> table =
+		 CodeTable::fromLengths(lengths, numSymbols, 0);
+
+	// the base value and extra bits of each bucket
+	uint64_t base[NUM_INTEGER_BUCKETS];
+	int extra[NUM_INTEGER_BUCKETS];
+	for (int s = 0; s < NUM_INTEGER_BUCKETS; s++)
+	{
+		base[s] = bucketBase(s, extra[s]);
+	}
+
+	BitReader reader(data + pos, size - pos);
+	for (uint64_t i = 0; i < count; i++)
+	{
+		int symbol = table->decodeSymbol(reader);
+		if (symbol < 0 || (uint64_t)extra[symbol] > reader.remaining() ||
+			 base[symbol] > numeric_limits<T>::max())
+		{
+			return 0;
+		}
+		uint64_t value = base[symbol];
+		int bits = extra[symbol];
+		if (bits > MAX_BITS_PER_CALL)
+		{
+			value |= reader.read(bits - MAX_BITS_PER_CALL) << MAX_BITS_PER_CALL;
+			bits = MAX_BITS_PER_CALL;
+		}
+		if (bits > 0)
+		{
+			value |= reader.read(bits);
+		}
+		out.push_back((T)value);
+	}
+	return pos + (reader.position() + 7) / 8;
+}
@@ -0,0 +1,107 @@
+/*
+ * @file IntegerCodec.h
+ * @author Katarina McGaughy
+ * IntegerCodec class: The IntegerCodec class compresses arrays of
+ * integers, such as deltas, IDs and timestamps, that do not fit a 26 or
+ * 256 symbol alphabet. Each value is split into a bucket symbol and raw
+ * extra bits. Small values are their own bucket, and larger values are
+ * bucketed by their bit length and the bit below the leading 1, so the
+ * buckets grow on a log scale and only the bucket carries the skew of
+ * the data. The buckets are Huffman coded with code lengths from
+ * HuffmanAlgorithm::buildCodeLengths, and the extra bits are written
+ * right after each code.
+ *
+ * Features:
+ * -encode and decode arrays of uint32_t or uint64_t
+ * -INTEGER_DIRECT_VALUES values coded by bucket alone, 2 buckets per
+ *  bit length above them
+ * -codebook stored as a CodebookHeader
+ *
+ * Format:
+ * -number of values as a varint
+ * -if there are any values, a CodebookHeader for the bucket symbols,
+ *  then each bucket code followed by its extra bits, most significant
+ *  first, padded to a whole byte
+ *
+ * Assumptions:
+ * -a stream written from uint64_t values is decoded as uint64_t, and
+ *  decoding it as uint32_t fails if a value does not fit
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// values below this are a bucket of their own with no extra bits
+const int INTEGER_DIRECT_VALUES = 16;
+
+// buckets for every 64 bit value: the direct values, then 2 for each
+// bit length from 5 to 64
+const int NUM_INTEGER_BUCKETS = INTEGER_DIRECT_VALUES + 2 * (64 - 4);
+
+class IntegerCodec
+{
+public:
+	/**
+	 * encode
+	 * this function counts the buckets of the values, builds their
+	 * codebook and appends the coded values to out
+	 * Preconditions: none
+	 * Postconditions: the coded values are appended to out
+	 * @param values: pointer to the values
+	 * @param count: number of values
+	 * @param out: vector the bytes are appended to
+	 */
+	static void encode(const uint32_t *values, size_t count,
+							 vector<uint8_t> &out);
+	static void encode(const uint64_t *values, size_t count,
+							 vector<uint8_t> &out);
+
+	/**
+	 * decode
+	 * this function reads coded values and appends them to out
+	 * Preconditions: none
+	 * Postconditions: returns the number of bytes read, or 0 if the
+	 * data is malformed, ends early or, for uint32_t, holds a value that
+	 * does not fit
+	 * @param data: pointer to the coded values
+	 * @param size: number of bytes available
+	 * @param out: vector the values are appended to
+	 * @return: number of bytes read, 0 on error
+	 */
+	static size_t decode(const uint8_t *data, size_t size,
+								vector<uint32_t> &out);
+	static size_t decode(const uint8_t *data, size_t size,
+								vector<uint64_t> &out);
+
+	/**
+	 * bucketOf
+	 * Preconditions: none
+	 * Postconditions: returns the bucket symbol of value and sets
+	 * extraBits to the number of raw bits that follow its code
+	 * @param value: integer to bucket
+	 * @param extraBits: set to the number of extra bits
+	 * @return: bucket symbol below NUM_INTEGER_BUCKETS
+	 */
+	static int bucketOf(uint64_t value, int &extraBits);
+
+private:
+	/**
+	 * encodeValues, decodeValues
+	 * the shared code behind encode and decode for each integer type
+	 */
+	template <typename T>
+	static void encodeValues(const T *values, size_t count,
+									 vector<uint8_t> &out);
+	template <typename T>
+	static size_t decodeValues(const uint8_t *data, size_t size,
+										vector<T> &out);
+};
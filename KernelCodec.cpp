@@ -0,0 +1,330 @@
+/*
+ * @file KernelCodec.cpp
+ * @author Katarina McGaughy
+ * KernelCodec class: The KernelCodec class encodes and decodes packed
+ * codes with loops specialized at compile time for the longest code in
+ * the codebook. A 64 bit register loaded or stored once holds at least
+ * 56 bits, so with codes of at most maxLength bits it holds
+ * 56 / maxLength whole codes. Each kernel handles that many symbols per
+ * load or store with no check between them: 7 for 8 bit codes, 5 for
+ * 11, 4 for 12 and 3 for 16. Only the last few symbols and the end of
+ * the data go through a checked loop. The kernel is picked at run time
+ * from the lengths of the CodeTable.
+ *
+ * Features:
+ * -kernels for maximum code lengths of 8, 11, 12 and 16 bits
+ * -encode table of code and length per symbol, decode table of symbol
+ *  and length for every maxLength bit pattern
+ * -codebooks with longer codes go through CodeTable
+ * -output and failures match CodeTable::encode and CodeTable::decode
+ * -encode can fold a RunningCrc32c over the bytes after each store
+ *
+ * Assumptions:
+ * -symbols fit in a byte
+ * -the CodeTable is held by shared pointer, so it lives as long as the
+ *  KernelCodec
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "KernelCodec.h"
+#include "Dictionary.h"
+
+// code lengths there is a kernel for, shortest first
+static const int KERNEL_LENGTHS[] = {8, 11, 12, 16};
+
+/**
+ * loadBigEndian
+ * Preconditions: p must have 8 readable bytes
+ * Postconditions: returns the 8 bytes with p[0] as the high byte
+ */
+static inline uint64_t loadBigEndian(const uint8_t *p)
+{
+	uint64_t value = 0;
+	for (int k = 0; k < 8; k++)
+	{
+		value = (value << 8) | p[k];
+	}
+	return value;
+}
+
+/**
+ * storeBigEndian
+ * Preconditions: p must have 8 writable bytes
+ * Postconditions: the 8 bytes of value are stored high byte first
+ */
+static inline void storeBigEndian(uint8_t *p, uint64_t value)
+{
+	for (int k = 0; k < 8; k++)
+	{
+		p[k] = (uint8_t)(value >> (56 - 8 * k));
+	}
+}
+
+/**
+ * Overloaded constructor
+ * this function picks the smallest kernel that fits the longest
+ * code and builds its encode and decode tables
+ * Preconditions: none
+ * Postconditions: getKernelLength() is 8, 11, 12 or 16, or 0 if
+ * the codes are too long and CodeTable is used
+ * @param table: CodeTable to encode and decode with
+ */
+KernelCodec::KernelCodec(shared_ptr<const CodeTable> table) : table_(table)
+{
+	if (table_->size() > NUM_BYTE_SYMBOLS)
+	{
+		return;
+	}
+	int maxLength = 0;
+	for (int s = 0; s < table_->size(); s++)
+	{
+		if (table_->getLength(s) > maxLength)
+		{
+			maxLength = table_->getLength(s);
+		}
+	}
+	for (int length : KERNEL_LENGTHS)
+	{
+		if (maxLength > 0 && maxLength <= length)
+		{
+			kernelLength_ = length;
+			break;
+		}
+	}
+	if (kernelLength_ == 0)
+	{
+		return;
+	}
+
+	// bytes outside the alphabet keep a length of 0
+	encodeTable_.assign(NUM_BYTE_SYMBOLS, 0);
+	decodeTable_.assign((size_t)1 << kernelLength_, 0);
+	for (int s = 0; s < table_->size(); s++)
+	{
+		int length = table_->getLength(s);
+		if (length == 0)
+		{
+			continue;
+		}
+		uint64_t bits = table_->getBits(s);
+		encodeTable_[s] = (uint32_t)(bits << 5) | length;
+
+		// every pattern that starts with the code
+		size_t first = (size_t)bits << (kernelLength_ - length);
+		size_t count = (size_t)1 << (kernelLength_ - length);
+		for (size_t k = 0; k < count; k++)
+		{
+			decodeTable_[first + k] = (uint16_t)((s << 5) | length);
+		}
+	}
+}
+
+int KernelCodec::getKernelLength() const
+{
+	return kernelLength_;
+}
+
+/**
+ * encode
+ * this function appends the codes for data to out, padded to a
+ * whole byte, the same bytes as CodeTable::encode through a new
+ * BitWriter on out followed by flush
+ * Preconditions: every byte must be a symbol with a code
+ * Postconditions: the packed codes are appended to out, and folded
+ * into crc as they are stored
+ * @param data: pointer to the bytes
+ * @param size: number of bytes
+ * @param out: vector the packed codes are appended to
+ * @param crc: RunningCrc32c over out, or nullptr
+ */
+void KernelCodec::encode(const uint8_t *data, size_t size,
+								 vector<uint8_t> &out, RunningCrc32c *crc) const
+{
+	switch (kernelLength_)
+	{
+	case 8:
+		encodeKernel<8>(data, size, out, crc);
+		break;
+	case 11:
+		encodeKernel<11>(data, size, out, crc);
+		break;
+	case 12:
+		encodeKernel<12>(data, size, out, crc);
+		break;
+	case 16:
+		encodeKernel<16>(data, size, out, crc);
+		break;
+	default:
+	{
+		BitWriter writer(out, crc);
+		table_->encode(data, size, writer);
+		writer.flush();
+	}
+	}
+}
+
+/**
+ * decode
+ * this function reads count symbols from the start of data and
+ * appends them to out as bytes
+ * Preconditions: none
+ * Postconditions: returns false if the data ends early or holds a
+ * pattern no code starts with, out then holds the symbols before
+ * it. bitsRead is set to the bits the symbols took
+ * @param data: pointer to the packed codes
+ * @param size: number of bytes
+ * @param count: number of symbols to read
+ * @param out: vector the bytes are appended to
+ * @param bitsRead: set to the number of bits read
+ * @return: true if count symbols were read
+ */
+bool KernelCodec::decode(const uint8_t *data, size_t size, size_t count,
+								 vector<uint8_t> &out, uint64_t &bitsRead) const
+{
+	switch (kernelLength_)
+	{
+	case 8:
+		return decodeKernel<8>(data, size, count, out, bitsRead);
+	case 11:
+		return decodeKernel<11>(data, size, count, out, bitsRead);
+	case 12:
+		return decodeKernel<12>(data, size, count, out, bitsRead);
+	case 16:
+		return decodeKernel<16>(data, size, count, out, bitsRead);
+	default:
+	{
+		BitReader reader(data, size);
+		bool complete = table_->decode(reader, count, out);
+		bitsRead = reader.position();
+		return complete;
+	}
+	}
+}
+
+/**
+ * encodeKernel
+ * this function adds 56 / MaxLength codes to the bit register at a
+ * time and stores it once, then codes the last symbols one at a time
+ * Preconditions: every code must be at most MaxLength bits
+ * Postconditions: the packed codes are appended to out, and folded
+ * into crc as they are stored
+ */
+template <int MaxLength>
+void KernelCodec::encodeKernel(const uint8_t *data, size_t size,
+										 vector<uint8_t> &out, RunningCrc32c *crc) const
+{
+	constexpr size_t perStore = 56 / MaxLength;
+	const uint32_t *table = encodeTable_.data();
+
+	// room for every code, and for the 8 bytes of the last store
+	size_t begin = out.size();
+	out.resize(begin + (size * MaxLength + 7) / 8 + 8);
+	uint8_t *next = out.data() + begin;
+
+	// the low used bits of bits are not stored yet, used stays below 8
+	// between stores so the register never holds more than 63 bits
+	uint64_t bits = 0;
+	int used = 0;
+	size_t i = 0;
+	for (; i + perStore <= size; i += perStore)
+	{
+		for (size_t k = 0; k < perStore; k++)
+		{
+			uint32_t entry = table[data[i + k]];
+			bits = (bits << (entry & 0x1F)) | (entry >> 5);
+			used += entry & 0x1F;
+		}
+		storeBigEndian(next, bits << (63 - used) << 1);
+		next += used >> 3;
+		used &= 7;
+
+		// the bytes before next are final, the one at next is not
+		if (crc != nullptr)
+		{
+			crc->fold(next - out.data());
+		}
+	}
+	for (; i < size; i++)
+	{
+		uint32_t entry = table[data[i]];
+		bits = (bits << (entry & 0x1F)) | (entry >> 5);
+		used += entry & 0x1F;
+		storeBigEndian(next, bits << (63 - used) << 1);
+		next += used >> 3;
+		used &= 7;
+	}
+	if (used > 0)
+	{
+		*next++ = (uint8_t)(bits << (8 - used));
+	}
+	out.resize(next - out.data());
+}
+
+/**
+ * decodeKernel
+ * this function loads 8 bytes and decodes 56 / MaxLength codes from
+ * them at a time while the load stays inside the data, then decodes
+ * the rest one code at a time, checking each against the end
+ * Preconditions: every code must be at most MaxLength bits
+ * Postconditions: returns false if the data ends early or holds a
+ * pattern no code starts with
+ */
+template <int MaxLength>
+bool KernelCodec::decodeKernel(const uint8_t *data, size_t size, size_t count,
+										 vector<uint8_t> &out, uint64_t &bitsRead) const
+{
+	constexpr size_t perLoad = 56 / MaxLength;
+	const uint16_t *table = decodeTable_.data();
+	uint64_t totalBits = (uint64_t)size * 8;
+
+	// every code is at least 1 bit, so there are at most as many
+	// symbols as bits
+	size_t begin = out.size();
+	size_t room = count < totalBits ? count : totalBits;
+	out.resize(begin + room);
+	uint8_t *symbols = out.data() + begin;
+
+	size_t done = 0;
+	uint64_t position = 0;
+	while (room - done >= perLoad && (position >> 3) + 8 <= size)
+	{
+		// at least 57 bits of the load are left after the shift
+		uint64_t window = loadBigEndian(data + (position >> 3))
+							  << (position & 7);
+		int bits = 0;
+		bool matched = true;
+		for (size_t k = 0; k < perLoad; k++)
+		{
+			uint16_t entry = table[(window << bits) >> (64 - MaxLength)];
+			symbols[done + k] = (uint8_t)(entry >> 5);
+			bits += entry & 0x1F;
+			matched = matched && (entry & 0x1F) != 0;
+		}
+		// the checked loop below stops at the pattern with no code
+		if (!matched)
+		{
+			break;
+		}
+		done += perLoad;
+		position += bits;
+	}
+	while (done < room)
+	{
+		BitReader reader(data, size, position);
+		uint16_t entry = table[reader.peek(MaxLength)];
+		int length = entry & 0x1F;
+		if (length == 0 || (uint64_t)length > totalBits - position)
+		{
+			break;
+		}
+		symbols[done++] = (uint8_t)(entry >> 5);
+		position += length;
+	}
+	out.resize(begin + done);
+	bitsRead = position;
+	return done == count;
+}
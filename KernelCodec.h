@@ -0,0 +1,129 @@
+/*
+ * @file KernelCodec.h
+ * @author Katarina McGaughy
+ * KernelCodec class: The KernelCodec class encodes and decodes packed
+ * codes with loops specialized at compile time for the longest code in
+ * the codebook. A 64 bit register loaded or stored once holds at least
+ * 56 bits, so with codes of at most maxLength bits it holds
+ * 56 / maxLength whole codes. Each kernel handles that many symbols per
+ * load or store with no check between them: 7 for 8 bit codes, 5 for
+ * 11, 4 for 12 and 3 for 16. Only the last few symbols and the end of
+ * the data go through a checked loop. The kernel is picked at run time
+ * from the lengths of the CodeTable.
+ *
+ * Features:
+ * -kernels for maximum code lengths of 8, 11, 12 and 16 bits
+ * -encode table of code and length per symbol, decode table of symbol
+ *  and length for every maxLength bit pattern
+ * -codebooks with longer codes go through CodeTable
+ * -output and failures match CodeTable::encode and CodeTable::decode
+ * -encode can fold a RunningCrc32c over the bytes after each store
+ *
+ * Assumptions:
+ * -symbols fit in a byte
+ * -the CodeTable is held by shared pointer, so it lives as long as the
+ *  KernelCodec
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "CodeTable.h"
+#include "Crc32c.h"
+using namespace std;
+
+// longest code any kernel handles
+const int MAX_KERNEL_LENGTH = 16;
+
+// blocks with fewer symbols decode faster through CodeTable than it
+// takes to fill the kernel tables
+const size_t MIN_KERNEL_SYMBOLS = 4096;
+
+class KernelCodec
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * this function picks the smallest kernel that fits the longest
+	 * code and builds its encode and decode tables
+	 * Preconditions: none
+	 * Postconditions: getKernelLength() is 8, 11, 12 or 16, or 0 if
+	 * the codes are too long and CodeTable is used
+	 * @param table: CodeTable to encode and decode with
+	 */
+	explicit KernelCodec(shared_ptr<const CodeTable> table);
+
+	/**
+	 * getKernelLength
+	 * Preconditions: none
+	 * Postconditions: returns the code length the kernel is built for,
+	 * or 0 if there is no kernel
+	 * @return: 8, 11, 12, 16 or 0
+	 */
+	int getKernelLength() const;
+
+	/**
+	 * encode
+	 * this function appends the codes for data to out, padded to a
+	 * whole byte, the same bytes as CodeTable::encode through a new
+	 * BitWriter on out followed by flush
+	 * Preconditions: every byte must be a symbol with a code
+	 * Postconditions: the packed codes are appended to out, and folded
+	 * into crc as they are stored
+	 * @param data: pointer to the bytes
+	 * @param size: number of bytes
+	 * @param out: vector the packed codes are appended to
+	 * @param crc: RunningCrc32c over out, or nullptr
+	 */
+	void encode(const uint8_t *data, size_t size, vector<uint8_t> &out,
+					RunningCrc32c *crc = nullptr) const;
+
+	/**
+	 * decode
+	 * this function reads count symbols from the start of data and
+	 * appends them to out as bytes
+	 * Preconditions: none
+	 * Postconditions: returns false if the data ends early or holds a
+	 * pattern no code starts with, out then holds the symbols before
+	 * it. bitsRead is set to the bits the symbols took
+	 * @param data: pointer to the packed codes
+	 * @param size: number of bytes
+	 * @param count: number of symbols to read
+	 * @param out: vector the bytes are appended to
+	 * @param bitsRead: set to the number of bits read
+	 * @return: true if count symbols were read
+	 */
+	bool decode(const uint8_t *data, size_t size, size_t count,
+					vector<uint8_t> &out, uint64_t &bitsRead) const;
+
+private:
+	/**
+	 * encodeKernel, decodeKernel
+	 * the loops for codes of at most MaxLength bits
+	 */
+	template <int MaxLength>
+	void encodeKernel(const uint8_t *data, size_t size, vector<uint8_t> &out,
+							RunningCrc32c *crc) const;
+	template <int MaxLength>
+	bool decodeKernel(const uint8_t *data, size_t size, size_t count,
+							vector<uint8_t> &out, uint64_t &bitsRead) const;
+
+	shared_ptr<const CodeTable> table_;
+
+	int kernelLength_ = 0;
+
+	// code << 5 | length for each symbol
+	vector<uint32_t> encodeTable_;
+
+	// symbol << 5 | length for each kernelLength_ bit pattern, a
+	// length of 0 where no code matches
+	vector<uint16_t> decodeTable_;
+};
@@ -0,0 +1,179 @@
+/*
+ * @file LookupDecoder.cpp
+ * @author Katarina McGaughy
+ * LookupDecoder class: The LookupDecoder class decodes a prefix code
+ * with table lookups instead of walking a binary trie a bit at a time.
+ * A single table indexed by the longest code stops fitting in the cache
+ * once codes pass about 12 bits, so a small primary table is indexed by
+ * the first bits of the code, and codes longer than that continue in a
+ * subtable for their prefix. Most codes finish in the primary table.
+ *
+ * Features:
+ * -primary table sized from the code lengths: the fewest bits, up to
+ *  MAX_PRIMARY_BITS, whose codes make up 99% of the Kraft sum (about the
+ *  share of symbols a Huffman code decodes from them)
+ * -subtables only as wide as the longest code under their prefix, up to
+ *  MAX_SUBTABLE_BITS, with a further subtable for the rare longer codes
+ * -entries packed into 32 bits so the primary table stays in L1
+ *
+ * Assumptions:
+ * -codes are at most MAX_BITS_PER_CALL bits and form a prefix code
+ * -there are fewer than 2^24 symbols and table entries
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "LookupDecoder.h"
+
+// share of the Kraft sum the primary table should decode on its own
+static const double PRIMARY_COVERAGE = 0.99;
+
+// an entry holds a symbol or table offset in its top 24 bits
+static const size_t MAX_ENTRY_VALUE = (size_t)1 << 24;
+
+/**
+ * Overloaded constructor
+ * this function picks the primary table size from the code lengths
+ * and fills the primary table and subtables
+ * Preconditions: bits and lengths must have numSymbols entries and
+ * form a prefix code, 0 marks a symbol without a code
+ * Postconditions: isValid() is false if a code is longer than
+ * MAX_BITS_PER_CALL or there are too many entries
+ * @param bits: code of each symbol, right aligned
+ * @param lengths: length of the code of each symbol
+ * @param numSymbols: number of symbols in the alphabet
+ */
+LookupDecoder::LookupDecoder(const uint64_t bits[], const int lengths[],
+									  int numSymbols)
+{
+	if ((size_t)numSymbols >= MAX_ENTRY_VALUE)
+	{
+		return;
+	}
+	vector<Code> codes;
+	vector<double> kraft(MAX_BITS_PER_CALL + 1, 0);
+	int maxLength = 0;
+	for (int i = 0; i < numSymbols; i++)
+	{
+		if (lengths[i] > MAX_BITS_PER_CALL)
+		{
+			return;
+		}
+		if (lengths[i] > 0)
+		{
+			Code code;
+			code.bits = bits[i];
+			code.length = lengths[i];
+			code.symbol = i;
+			codes.push_back(code);
+			kraft[lengths[i]] += 1.0 / ((uint64_t)1 << lengths[i]);
+			if (lengths[i] > maxLength)
+			{
+				maxLength = lengths[i];
+			}
+		}
+	}
+
+	// the fewest bits that decode nearly every symbol on their own
+	double total = 0;
+	for (int len = 1; len <= maxLength; len++)
+	{
+		total += kraft[len];
+	}
+	int limit = maxLength < MAX_PRIMARY_BITS ? maxLength : MAX_PRIMARY_BITS;
+	primaryBits_ = 1;
+	double covered = kraft[1];
+	while (primaryBits_ < limit && covered < PRIMARY_COVERAGE * total)
+	{
+		primaryBits_++;
+		covered += kraft[primaryBits_];
+	}
+
+	table_.assign((size_t)1 << primaryBits_, 0);
+	valid_ = fill(0, primaryBits_, 0, codes);
+	if (!valid_)
+	{
+		table_.clear();
+	}
+}
+
+/**
+ * fill
+ * this function fills the table of 2^width entries at offset with
+ * codes, whose first consumed bits are already used, and adds
+ * subtables for the codes that do not fit
+ * Preconditions: the table must already be in table_
+ * Postconditions: returns false if there are too many entries
+ */
+bool LookupDecoder::fill(size_t offset, int width, int consumed,
+								 const vector<Code> &codes)
+{
+	// a code that fits takes every entry its bits are a prefix of,
+	// longer codes are grouped by their next width bits
+	vector<vector<Code>> longer((size_t)1 << width);
+	for (const Code &code : codes)
+	{
+		int rest = code.length - consumed;
+		uint64_t tail = code.bits & (((uint64_t)1 << rest) - 1);
+		if (rest <= width)
+		{
+			size_t first = tail << (width - rest);
+			size_t count = (size_t)1 << (width - rest);
+			for (size_t k = 0; k < count; k++)
+			{
+				table_[offset + first + k] = ((uint32_t)code.symbol << 8) | rest;
+			}
+		}
+		else
+		{
+			longer[tail >> (rest - width)].push_back(code);
+		}
+	}
+
+	for (size_t index = 0; index < longer.size(); index++)
+	{
+		if (longer[index].empty())
+		{
+			continue;
+		}
+		int longest = 0;
+		for (const Code &code : longer[index])
+		{
+			if (code.length - consumed - width > longest)
+			{
+				longest = code.length - consumed - width;
+			}
+		}
+		int subBits = longest < MAX_SUBTABLE_BITS ? longest : MAX_SUBTABLE_BITS;
+		size_t subOffset = table_.size();
+		if (subOffset + ((size_t)1 << subBits) > MAX_ENTRY_VALUE)
+		{
+			return false;
+		}
+		table_.resize(subOffset + ((size_t)1 << subBits), 0);
+		table_[offset + index] = ((uint32_t)subOffset << 8) | (subBits << 4);
+		if (!fill(subOffset, subBits, consumed + width, longer[index]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool LookupDecoder::isValid() const
+{
+	return valid_;
+}
+
+int LookupDecoder::getPrimaryBits() const
+{
+	return primaryBits_;
+}
+
+size_t LookupDecoder::getTableSize() const
+{
+	return table_.size();
+}
@@ -0,0 +1,139 @@
+/*
+ * @file LookupDecoder.h
+ * @author Katarina McGaughy
+ * LookupDecoder class: The LookupDecoder class decodes a prefix code
+ * with table lookups instead of walking a binary trie a bit at a time.
+ * A single table indexed by the longest code stops fitting in the cache
+ * once codes pass about 12 bits, so a small primary table is indexed by
+ * the first bits of the code, and codes longer than that continue in a
+ * subtable for their prefix. Most codes finish in the primary table.
+ *
+ * Features:
+ * -primary table sized from the code lengths: the fewest bits, up to
+ *  MAX_PRIMARY_BITS, whose codes make up 99% of the Kraft sum (about the
+ *  share of symbols a Huffman code decodes from them)
+ * -subtables only as wide as the longest code under their prefix, up to
+ *  MAX_SUBTABLE_BITS, with a further subtable for the rare longer codes
+ * -entries packed into 32 bits so the primary table stays in L1
+ *
+ * Assumptions:
+ * -codes are at most MAX_BITS_PER_CALL bits and form a prefix code
+ * -there are fewer than 2^24 symbols and table entries
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BitStream.h"
+using namespace std;
+
+// widest primary table and subtable, as powers of 2
+const int MAX_PRIMARY_BITS = 11;
+const int MAX_SUBTABLE_BITS = 8;
+
+class LookupDecoder
+{
+public:
+	/**
+	 * Default constructor
+	 * Preconditions: none
+	 * Postconditions: LookupDecoder has no codes and isValid() is false
+	 */
+	LookupDecoder() = default;
+
+	/**
+	 * Overloaded constructor
+	 * this function picks the primary table size from the code lengths
+	 * and fills the primary table and subtables
+	 * Preconditions: bits and lengths must have numSymbols entries and
+	 * form a prefix code, 0 marks a symbol without a code
+	 * Postconditions: isValid() is false if a code is longer than
+	 * MAX_BITS_PER_CALL or there are too many entries
+	 * @param bits: code of each symbol, right aligned
+	 * @param lengths: length of the code of each symbol
+	 * @param numSymbols: number of symbols in the alphabet
+	 */
+	LookupDecoder(const uint64_t bits[], const int lengths[], int numSymbols);
+
+	/**
+	 * isValid, getPrimaryBits, getTableSize
+	 * Preconditions: none
+	 * Postconditions: return whether the tables were built, the bits
+	 * the primary table is indexed by, and the number of entries in all
+	 * tables
+	 */
+	bool isValid() const;
+	int getPrimaryBits() const;
+	size_t getTableSize() const;
+
+	/**
+	 * decodeSymbol
+	 * this function looks up the next bits in the primary table and,
+	 * for long codes, in the subtables below it
+	 * Preconditions: isValid() must be true
+	 * Postconditions: returns the symbol read, or -1 if the data ends
+	 * before the code is complete or no code starts with the bits
+	 * @param in: BitReader positioned at the start of a code
+	 * @return: index of the symbol or -1
+	 */
+	int decodeSymbol(BitReader &in) const
+	{
+		size_t offset = 0;
+		int width = primaryBits_;
+		while (true)
+		{
+			uint32_t entry = table_[offset + in.peek(width)];
+			int subBits = (entry >> 4) & 0xF;
+			if (subBits == 0)
+			{
+				int numBits = entry & 0xF;
+				if (numBits == 0 || (uint64_t)numBits > in.remaining())
+				{
+					return -1;
+				}
+				in.skip(numBits);
+				return entry >> 8;
+			}
+			in.skip(width);
+			offset = entry >> 8;
+			width = subBits;
+		}
+	}
+
+private:
+	/**
+	 * Code struct is one code while the tables are built
+	 */
+	struct Code
+	{
+		uint64_t bits = 0;
+		int length = 0;
+		int symbol = 0;
+	};
+
+	/**
+	 * fill
+	 * this function fills the table of 2^width entries at offset with
+	 * codes, whose first consumed bits are already used, and adds
+	 * subtables for the codes that do not fit
+	 * Preconditions: the table must already be in table_
+	 * Postconditions: returns false if there are too many entries
+	 */
+	bool fill(size_t offset, int width, int consumed, const vector<Code> &codes);
+
+	int primaryBits_ = 0;
+
+	// entries: value << 8 | subtable bits << 4 | code bits. value is
+	// the symbol for a code, or the offset of the subtable. An entry of
+	// 0 means no code starts with its bits
+	vector<uint32_t> table_;
+
+	bool valid_ = false;
+};
@@ -0,0 +1,172 @@
+/*
+ * @file MultiSymbolDecoder.cpp
+ * @author Katarina McGaughy
+ * MultiSymbolDecoder class: The MultiSymbolDecoder class decodes up to
+ * three symbols with one table lookup. With skewed counts, such as
+ * letter frequencies, most codes are 2 to 4 bits long, so the next
+ * lookupBits bits of the stream usually hold more than one whole code.
+ * Each table entry lists every code that fits in its bits, up to three,
+ * and the number of bits they take together.
+ *
+ * Features:
+ * -table built by enumerating every sequence of one, two and three
+ *  codes that fits in lookupBits
+ * -entries packed into 32 bits: three symbols, the number of symbols
+ *  and the bits they take
+ * -codes longer than the table, and the last symbols of a block, go
+ *  through CodeTable::decodeSymbol
+ *
+ * Assumptions:
+ * -symbols fit in a byte
+ * -the CodeTable is held by shared pointer, so it lives as long as the
+ *  decoder
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "MultiSymbolDecoder.h"
+
+/**
+ * Overloaded constructor
+ * this function fills the table with every sequence of up to
+ * MAX_SYMBOLS_PER_ENTRY codes whose lengths add up to at most
+ * lookupBits
+ * Preconditions: lookupBits must be between 1 and
+ * MAX_MULTI_SYMBOL_BITS
+ * Postconditions: MultiSymbolDecoder is ready to decode
+ * @param table: CodeTable the stream is coded with
+ * @param lookupBits: bits the table is indexed by
+ */
+MultiSymbolDecoder::MultiSymbolDecoder(shared_ptr<const CodeTable> table,
+													int lookupBits)
+	: table_(table), lookupBits_(lookupBits),
+	  entries_((size_t)1 << lookupBits, 0)
+{
+	fill(0, 0, 0, 0);
+}
+
+/**
+ * fill
+ * this function adds every code that fits after a prefix of
+ * numSymbols codes, then the codes that fit after those
+ * Preconditions: prefixBits must be at most lookupBits_
+ * Postconditions: the entries starting with the prefix are filled
+ */
+void MultiSymbolDecoder::fill(uint32_t prefix, int prefixBits,
+										uint32_t symbols, int numSymbols)
+{
+	int numCodes = table_->size() < 256 ? table_->size() : 256;
+	for (int s = 0; s < numCodes; s++)
+	{
+		int length = table_->getLength(s);
+		int bits = prefixBits + length;
+		if (length == 0 || bits > lookupBits_)
+		{
+			continue;
+		}
+		uint32_t code = (prefix << length) | (uint32_t)table_->getBits(s);
+		uint32_t entrySymbols = symbols | ((uint32_t)s << (8 * numSymbols));
+
+		// every entry that starts with the codes so far, later sequences
+		// overwrite the entries they are a prefix of
+		uint32_t entry = (entrySymbols << 8) | ((numSymbols + 1) << 4) | bits;
+		size_t first = (size_t)code << (lookupBits_ - bits);
+		size_t count = (size_t)1 << (lookupBits_ - bits);
+		for (size_t k = 0; k < count; k++)
+		{
+			entries_[first + k] = entry;
+		}
+		if (numSymbols + 1 < MAX_SYMBOLS_PER_ENTRY)
+		{
+			fill(code, bits, entrySymbols, numSymbols + 1);
+		}
+	}
+}
+
+int MultiSymbolDecoder::getLookupBits() const
+{
+	return lookupBits_;
+}
+
+/**
+ * decode
+ * this function reads count symbols from in and appends them to out
+ * as bytes, taking as many symbols from each lookup as fit
+ * Preconditions: none
+ * Postconditions: returns false if the data ends early
+ * @param in: BitReader positioned at the first code
+ * @param count: number of symbols to read
+ * @param out: vector the bytes are appended to
+ * @return: true if count symbols were read
+ */
+bool MultiSymbolDecoder::decode(BitReader &in, size_t count,
+										  vector<uint8_t> &out) const
+{
+	size_t left = count;
+	while (left > 0)
+	{
+		uint32_t entry = entries_[in.peek(lookupBits_)];
+		size_t numSymbols = (entry >> 4) & 0x3;
+		int bits = entry & 0xF;
+		// a long code, or an entry that runs past the data or the block
+		if (numSymbols == 0 || numSymbols > left ||
+			 (uint64_t)bits > in.remaining())
+		{
+			int symbol = table_->decodeSymbol(in);
+			if (symbol < 0)
+			{
+				return false;
+			}
+			out.push_back((uint8_t)symbol);
+			left--;
+			continue;
+		}
+		for (size_t k = 0; k < numSymbols; k++)
+		{
+			out.push_back((uint8_t)(entry >> (8 + 8 * k)));
+		}
+		in.skip(bits);
+		left -= numSymbols;
+	}
+	return true;
+}
+
+/**
+ * countLookups
+ * this function decodes like decode but only counts the lookups, to
+ * show how many symbols each one returns
+ * Preconditions: none
+ * Postconditions: returns the number of table lookups decode would
+ * make, or 0 if the data ends early
+ * @param in: BitReader positioned at the first code
+ * @param count: number of symbols to read
+ * @return: number of lookups
+ */
+size_t MultiSymbolDecoder::countLookups(BitReader &in, size_t count) const
+{
+	size_t lookups = 0;
+	size_t left = count;
+	while (left > 0)
+	{
+		uint32_t entry = entries_[in.peek(lookupBits_)];
+		size_t numSymbols = (entry >> 4) & 0x3;
+		int bits = entry & 0xF;
+		lookups++;
+		if (numSymbols == 0 || numSymbols > left ||
+			 (uint64_t)bits > in.remaining())
+		{
+			if (table_->decodeSymbol(in) < 0)
+			{
+				return 0;
+			}
+			left--;
+			continue;
+		}
+		in.skip(bits);
+		left -= numSymbols;
+	}
+	return lookups;
+}
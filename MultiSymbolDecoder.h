@@ -0,0 +1,114 @@
+/*
+ * @file MultiSymbolDecoder.h
+ * @author Katarina McGaughy
+ * MultiSymbolDecoder class: The MultiSymbolDecoder class decodes up to
+ * three symbols with one table lookup. With skewed counts, such as
+ * letter frequencies, most codes are 2 to 4 bits long, so the next
+ * lookupBits bits of the stream usually hold more than one whole code.
+ * Each table entry lists every code that fits in its bits, up to three,
+ * and the number of bits they take together.
+ *
+ * Features:
+ * -table built by enumerating every sequence of one, two and three
+ *  codes that fits in lookupBits
+ * -entries packed into 32 bits: three symbols, the number of symbols
+ *  and the bits they take
+ * -codes longer than the table, and the last symbols of a block, go
+ *  through CodeTable::decodeSymbol
+ *
+ * Assumptions:
+ * -symbols fit in a byte
+ * -the CodeTable is held by shared pointer, so it lives as long as the
+ *  decoder
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "CodeTable.h"
+using namespace std;
+
+// most symbols in one table entry
+const int MAX_SYMBOLS_PER_ENTRY = 3;
+
+// bits the table is indexed by, and the widest it may be
+const int DEFAULT_MULTI_SYMBOL_BITS = 11;
+const int MAX_MULTI_SYMBOL_BITS = 15;
+
+class MultiSymbolDecoder
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * this function fills the table with every sequence of up to
+	 * MAX_SYMBOLS_PER_ENTRY codes whose lengths add up to at most
+	 * lookupBits
+	 * Preconditions: lookupBits must be between 1 and
+	 * MAX_MULTI_SYMBOL_BITS
+	 * Postconditions: MultiSymbolDecoder is ready to decode
+	 * @param table: CodeTable the stream is coded with
+	 * @param lookupBits: bits the table is indexed by
+	 */
+	MultiSymbolDecoder(shared_ptr<const CodeTable> table,
+							 int lookupBits = DEFAULT_MULTI_SYMBOL_BITS);
+
+	/**
+	 * getLookupBits
+	 * Preconditions: none
+	 * Postconditions: returns the bits the table is indexed by
+	 * @return: number of bits
+	 */
+	int getLookupBits() const;
+
+	/**
+	 * decode
+	 * this function reads count symbols from in and appends them to out
+	 * as bytes, taking as many symbols from each lookup as fit
+	 * Preconditions: none
+	 * Postconditions: returns false if the data ends early
+	 * @param in: BitReader positioned at the first code
+	 * @param count: number of symbols to read
+	 * @param out: vector the bytes are appended to
+	 * @return: true if count symbols were read
+	 */
+	bool decode(BitReader &in, size_t count, vector<uint8_t> &out) const;
+
+	/**
+	 * countLookups
+	 * this function decodes like decode but only counts the lookups, to
+	 * show how many symbols each one returns
+	 * Preconditions: none
+	 * Postconditions: returns the number of table lookups decode would
+	 * make, or 0 if the data ends early
+	 * @param in: BitReader positioned at the first code
+	 * @param count: number of symbols to read
+	 * @return: number of lookups
+	 */
+	size_t countLookups(BitReader &in, size_t count) const;
+
+private:
+	/**
+	 * fill
+	 * this function adds every code that fits after a prefix of
+	 * numSymbols codes, then the codes that fit after those
+	 * Preconditions: prefixBits must be at most lookupBits_
+	 * Postconditions: the entries starting with the prefix are filled
+	 */
+	void fill(uint32_t prefix, int prefixBits, uint32_t symbols, int numSymbols);
+
+	shared_ptr<const CodeTable> table_;
+
+	int lookupBits_;
+
+	// entries: symbols << 8 | number of symbols << 4 | bits. An entry
+	// with no symbols starts with a code longer than lookupBits_
+	vector<uint32_t> entries_;
+};
@@ -0,0 +1,135 @@
+/*
+ * @file PairEncoder.cpp
+ * @author Katarina McGaughy
+ * PairEncoder class: The PairEncoder class encodes two symbols with one
+ * table lookup and one write. For a small alphabet, such as the 26
+ * letters of a HuffmanAlgorithm CodeBook, a table of every pair of
+ * symbols is small (676 entries for letters), and each entry holds the
+ * two codes joined together and their total length. When the alphabet
+ * is small enough and three of the longest codes fit in one write, a
+ * table of every triple is used instead.
+ *
+ * Features:
+ * -pair table of size^2 entries, triple table of size^3 entries
+ * -entries packed into 64 bits: the joined codes and their length
+ * -the last one or two symbols are coded on their own
+ * -output is bit for bit the same as CodeTable::encode
+ *
+ * Assumptions:
+ * -symbols are byte values below MAX_PAIR_SYMBOLS
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "PairEncoder.h"
+
+/**
+ * Overloaded constructor
+ * this function joins the codes of every pair of symbols, and of
+ * every triple if useTriples is set, the triple table would have at
+ * most MAX_TRIPLE_ENTRIES entries and three codes fit in one write
+ * Preconditions: table must have at most MAX_PAIR_SYMBOLS symbols,
+ * with codes of at most MAX_BITS_PER_CALL / 2 bits
+ * Postconditions: PairEncoder is ready to encode
+ * @param table: CodeTable to encode with
+ * @param useTriples: whether to build the triple table
+ */
+PairEncoder::PairEncoder(shared_ptr<const CodeTable> table, bool useTriples)
+	: table_(table), numSymbols_(table->size())
+{
+	int maxLength = 0;
+	for (int s = 0; s < numSymbols_; s++)
+	{
+		if (table_->getLength(s) > maxLength)
+		{
+			maxLength = table_->getLength(s);
+		}
+	}
+
+	int symbols[3];
+	pairs_.resize((size_t)numSymbols_ * numSymbols_);
+	for (symbols[0] = 0; symbols[0] < numSymbols_; symbols[0]++)
+	{
+		for (symbols[1] = 0; symbols[1] < numSymbols_; symbols[1]++)
+		{
+			pairs_[symbols[0] * numSymbols_ + symbols[1]] = join(symbols, 2);
+		}
+	}
+
+	size_t tripleEntries = pairs_.size() * numSymbols_;
+	if (!useTriples || tripleEntries > MAX_TRIPLE_ENTRIES ||
+		 3 * maxLength > MAX_BITS_PER_CALL)
+	{
+		return;
+	}
+	triples_.resize(tripleEntries);
+	for (size_t pair = 0; pair < pairs_.size(); pair++)
+	{
+		symbols[0] = pair / numSymbols_;
+		symbols[1] = pair % numSymbols_;
+		for (symbols[2] = 0; symbols[2] < numSymbols_; symbols[2]++)
+		{
+			triples_[pair * numSymbols_ + symbols[2]] = join(symbols, 3);
+		}
+	}
+}
+
+/**
+ * join
+ * Preconditions: the codes must fit in MAX_BITS_PER_CALL bits
+ * Postconditions: returns the entry for the symbols in order
+ */
+uint64_t PairEncoder::join(const int symbols[], int count) const
+{
+	uint64_t bits = 0;
+	int length = 0;
+	for (int k = 0; k < count; k++)
+	{
+		bits = (bits << table_->getLength(symbols[k])) |
+				 table_->getBits(symbols[k]);
+		length += table_->getLength(symbols[k]);
+	}
+	return (bits << 6) | length;
+}
+
+int PairEncoder::getSymbolsPerLookup() const
+{
+	return triples_.empty() ? 2 : 3;
+}
+
+/**
+ * encode
+ * this function writes the codes for data, two or three symbols at
+ * a time, and the last symbols one at a time
+ * Preconditions: every byte must be a symbol with a code
+ * Postconditions: the codes are written to out
+ * @param data: pointer to the bytes
+ * @param size: number of bytes
+ * @param out: BitWriter the codes are written to
+ */
+void PairEncoder::encode(const uint8_t *data, size_t size, BitWriter &out) const
+{
+	size_t i = 0;
+	if (!triples_.empty())
+	{
+		for (; i + 3 <= size; i += 3)
+		{
+			uint64_t entry = triples_[(data[i] * numSymbols_ + data[i + 1]) *
+													numSymbols_ +
+												data[i + 2]];
+			out.write(entry >> 6, entry & 0x3F);
+		}
+	}
+	for (; i + 2 <= size; i += 2)
+	{
+		uint64_t entry = pairs_[data[i] * numSymbols_ + data[i + 1]];
+		out.write(entry >> 6, entry & 0x3F);
+	}
+	if (i < size)
+	{
+		table_->encodeSymbol(data[i], out);
+	}
+}
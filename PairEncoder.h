@@ -0,0 +1,93 @@
+/*
+ * @file PairEncoder.h
+ * @author Katarina McGaughy
+ * PairEncoder class: The PairEncoder class encodes two symbols with one
+ * table lookup and one write. For a small alphabet, such as the 26
+ * letters of a HuffmanAlgorithm CodeBook, a table of every pair of
+ * symbols is small (676 entries for letters), and each entry holds the
+ * two codes joined together and their total length. When the alphabet
+ * is small enough and three of the longest codes fit in one write, a
+ * table of every triple is used instead.
+ *
+ * Features:
+ * -pair table of size^2 entries, triple table of size^3 entries
+ * -entries packed into 64 bits: the joined codes and their length
+ * -the last one or two symbols are coded on their own
+ * -output is bit for bit the same as CodeTable::encode
+ *
+ * Assumptions:
+ * -symbols are byte values below MAX_PAIR_SYMBOLS
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "CodeTable.h"
+using namespace std;
+
+// largest alphabet a pair table is built for
+const int MAX_PAIR_SYMBOLS = 64;
+
+// most entries in a triple table
+const size_t MAX_TRIPLE_ENTRIES = (size_t)1 << 15;
+
+class PairEncoder
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * this function joins the codes of every pair of symbols, and of
+	 * every triple if useTriples is set, the triple table would have at
+	 * most MAX_TRIPLE_ENTRIES entries and three codes fit in one write
+	 * Preconditions: table must have at most MAX_PAIR_SYMBOLS symbols,
+	 * with codes of at most MAX_BITS_PER_CALL / 2 bits
+	 * Postconditions: PairEncoder is ready to encode
+	 * @param table: CodeTable to encode with
+	 * @param useTriples: whether to build the triple table
+	 */
+	PairEncoder(shared_ptr<const CodeTable> table, bool useTriples = true);
+
+	/**
+	 * getSymbolsPerLookup
+	 * Preconditions: none
+	 * Postconditions: returns 3 if the triple table is used, else 2
+	 * @return: symbols coded by each lookup
+	 */
+	int getSymbolsPerLookup() const;
+
+	/**
+	 * encode
+	 * this function writes the codes for data, two or three symbols at
+	 * a time, and the last symbols one at a time
+	 * Preconditions: every byte must be a symbol with a code
+	 * Postconditions: the codes are written to out
+	 * @param data: pointer to the bytes
+	 * @param size: number of bytes
+	 * @param out: BitWriter the codes are written to
+	 */
+	void encode(const uint8_t *data, size_t size, BitWriter &out) const;
+
+private:
+	/**
+	 * join
+	 * Preconditions: the codes must fit in MAX_BITS_PER_CALL bits
+	 * Postconditions: returns the entry for the symbols in order
+	 */
+	uint64_t join(const int symbols[], int count) const;
+
+	shared_ptr<const CodeTable> table_;
+
+	int numSymbols_;
+
+	// entries: joined codes << 6 | total length
+	vector<uint64_t> pairs_;
+	vector<uint64_t> triples_;
+};
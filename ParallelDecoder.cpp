@@ -0,0 +1,157 @@
+/*
+ * @file ParallelDecoder.cpp
+ * @author Katarina McGaughy
+ * ParallelDecoder class: The ParallelDecoder class decodes a packed code
+ * stream that has no SeekIndex on several threads. The stream is cut
+ * into chunks at arbitrary bit positions, and every chunk after the
+ * first is decoded speculatively from its start, which is usually in
+ * the middle of a code. Prefix codes resynchronize within a few dozen
+ * bits, so once the decode of the chunk before is known to end on a
+ * code boundary the speculative decode has also passed, the rest of
+ * the speculative output is exactly what a serial decode would give.
+ * A chunk whose decode never meets that boundary is decoded again from
+ * it.
+ *
+ * Features:
+ * -one thread per chunk, each stopping at the first code that ends at
+ *  or after the start of the next chunk
+ * -code boundaries kept for the first MAX_SYNC_SYMBOLS symbols of each
+ *  chunk to find where it synchronized
+ * -chunks stitched in order, redoing those that did not synchronize
+ * -output matches CodeTable::decode, including failure when the data
+ *  ends early
+ *
+ * Assumptions:
+ * -the stream was written with CodeTable::encode from its first bit
+ * -the number of symbols is known, as it is in a BlockCodec block
+ * -symbols fit in a byte
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "ParallelDecoder.h"
+#include <algorithm>
+#include <thread>
+
+/**
+ * decode
+ * this function decodes count symbols from data on up to numThreads
+ * threads and appends them to out as bytes
+ * Preconditions: numThreads must be at least 1
+ * Postconditions: returns false if the data ends before count
+ * symbols, out then holds what was decoded
+ * @param table: CodeTable the stream is coded with
+ * @param data: pointer to the packed codes
+ * @param size: number of bytes
+ * @param count: number of symbols to read
+ * @param numThreads: most threads to use
+ * @param out: vector the bytes are appended to
+ * @return: true if count symbols were read
+ */
+bool ParallelDecoder::decode(const CodeTable &table, const uint8_t *data,
+									  size_t size, size_t count, int numThreads,
+									  vector<uint8_t> &out)
+{
+	uint64_t totalBits = (uint64_t)size * 8;
+	uint64_t numChunks = totalBits / MIN_PARALLEL_CHUNK_BITS;
+	if (numChunks > (uint64_t)numThreads)
+	{
+		numChunks = numThreads;
+	}
+	if (numChunks <= 1)
+	{
+		BitReader reader(data, size);
+		return table.decode(reader, count, out);
+	}
+
+	// decode every chunk at once, each from its arbitrary start
+	vector<Chunk> chunks(numChunks);
+	vector<thread> threads;
+	for (uint64_t k = 0; k < numChunks; k++)
+	{
+		chunks[k].start = k * totalBits / numChunks;
+		uint64_t stop = (k + 1) * totalBits / numChunks;
+		threads.emplace_back(decodeChunk, cref(table), data, size, stop,
+									ref(chunks[k]));
+	}
+	for (thread &worker : threads)
+	{
+		worker.join();
+	}
+
+	// chunk 0 starts on a boundary. Each later chunk continues from where
+	// the one before really ended, if its decode passed that point
+	size_t begin = out.size();
+	uint64_t position = 0;
+	for (uint64_t k = 0; k < numChunks; k++)
+	{
+		Chunk &chunk = chunks[k];
+		size_t first = 0;
+		if (k > 0)
+		{
+			auto found = lower_bound(chunk.boundaries.begin(),
+											 chunk.boundaries.end(), position);
+			if (found != chunk.boundaries.end() && *found == position)
+			{
+				first = found - chunk.boundaries.begin();
+			}
+			else
+			{
+				// never synchronized, decode the chunk again from the
+				// real boundary
+				uint64_t stop = (k + 1) * totalBits / numChunks;
+				chunk = Chunk();
+				chunk.start = position;
+				decodeChunk(table, data, size, stop, chunk);
+			}
+		}
+		size_t needed = count - (out.size() - begin);
+		size_t take = min(chunk.symbols.size() - first, needed);
+		out.insert(out.end(), chunk.symbols.begin() + first,
+					  chunk.symbols.begin() + first + take);
+		position = chunk.end;
+		if (out.size() - begin == count)
+		{
+			return true;
+		}
+		if (chunk.failed)
+		{
+			return false;
+		}
+	}
+	return out.size() - begin == count;
+}
+
+/**
+ * decodeChunk
+ * this function decodes from chunk.start until a code ends at or
+ * after stop, or no code matches
+ * Preconditions: chunk.start must be set
+ * Postconditions: chunk holds the symbols, boundaries and end
+ */
+void ParallelDecoder::decodeChunk(const CodeTable &table, const uint8_t *data,
+											 size_t size, uint64_t stop, Chunk &chunk)
+{
+	BitReader reader(data, size, chunk.start);
+	while (reader.position() < stop)
+	{
+		uint64_t position = reader.position();
+		int symbol = table.decodeSymbol(reader);
+		if (symbol < 0)
+		{
+			// the serial decode ends here too if it gets this far
+			reader.seek(position);
+			chunk.failed = true;
+			break;
+		}
+		if (chunk.boundaries.size() < MAX_SYNC_SYMBOLS)
+		{
+			chunk.boundaries.push_back(position);
+		}
+		chunk.symbols.push_back((uint8_t)symbol);
+	}
+	chunk.end = reader.position();
+}
@@ -0,0 +1,99 @@
+/*
+ * @file ParallelDecoder.h
+ * @author Katarina McGaughy
+ * ParallelDecoder class: The ParallelDecoder class decodes a packed code
+ * stream that has no SeekIndex on several threads. The stream is cut
+ * into chunks at arbitrary bit positions, and every chunk after the
+ * first is decoded speculatively from its start, which is usually in
+ * the middle of a code. Prefix codes resynchronize within a few dozen
+ * bits, so once the decode of the chunk before is known to end on a
+ * code boundary the speculative decode has also passed, the rest of
+ * the speculative output is exactly what a serial decode would give.
+ * A chunk whose decode never meets that boundary is decoded again from
+ * it.
+ *
+ * Features:
+ * -one thread per chunk, each stopping at the first code that ends at
+ *  or after the start of the next chunk
+ * -code boundaries kept for the first MAX_SYNC_SYMBOLS symbols of each
+ *  chunk to find where it synchronized
+ * -chunks stitched in order, redoing those that did not synchronize
+ * -output matches CodeTable::decode, including failure when the data
+ *  ends early
+ *
+ * Assumptions:
+ * -the stream was written with CodeTable::encode from its first bit
+ * -the number of symbols is known, as it is in a BlockCodec block
+ * -symbols fit in a byte
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CodeTable.h"
+using namespace std;
+
+// symbols of each chunk whose start positions are kept
+const size_t MAX_SYNC_SYMBOLS = 1024;
+
+// streams shorter than this many bits per thread are decoded serially
+const uint64_t MIN_PARALLEL_CHUNK_BITS = 1 << 16;
+
+class ParallelDecoder
+{
+public:
+	/**
+	 * decode
+	 * this function decodes count symbols from data on up to numThreads
+	 * threads and appends them to out as bytes
+	 * Preconditions: numThreads must be at least 1
+	 * Postconditions: returns false if the data ends before count
+	 * symbols, out then holds what was decoded
+	 * @param table: CodeTable the stream is coded with
+	 * @param data: pointer to the packed codes
+	 * @param size: number of bytes
+	 * @param count: number of symbols to read
+	 * @param numThreads: most threads to use
+	 * @param out: vector the bytes are appended to
+	 * @return: true if count symbols were read
+	 */
+	static bool decode(const CodeTable &table, const uint8_t *data, size_t size,
+							 size_t count, int numThreads, vector<uint8_t> &out);
+
+private:
+	/**
+	 * Chunk struct is the decode of one chunk
+	 */
+	struct Chunk
+	{
+		// bit position the decode started at, and where it stopped
+		uint64_t start = 0;
+		uint64_t end = 0;
+
+		// true if the decode stopped on a code no prefix matched or on
+		// the end of the data, instead of at the next chunk
+		bool failed = false;
+
+		vector<uint8_t> symbols;
+
+		// start position of the first MAX_SYNC_SYMBOLS symbols
+		vector<uint64_t> boundaries;
+	};
+
+	/**
+	 * decodeChunk
+	 * this function decodes from chunk.start until a code ends at or
+	 * after stop, or no code matches
+	 * Preconditions: chunk.start must be set
+	 * Postconditions: chunk holds the symbols, boundaries and end
+	 */
+	static void decodeChunk(const CodeTable &table, const uint8_t *data,
+									size_t size, uint64_t stop, Chunk &chunk);
+};
@@ -0,0 +1,229 @@
+/*
+ * @file SampledHistogram.cpp
+ * @author Katarina McGaughy
+ * SampledHistogram class: The SampledHistogram class estimates the byte
+ * counts of a large input from a fraction of its cache line sized
+ * chunks, so a codebook can be chosen without reading every byte. The
+ * input is cut into as many equal strata as chunks to sample and one
+ * chunk is taken from each, either the first chunk of the stratum or
+ * a random one. The sampled counts are scaled up to the size of the
+ * input, so they can be used anywhere exact counts are.
+ *
+ * Features:
+ * -evenly spaced or random chunks, with a seed for repeatable results
+ * -counts scaled to the input size, every symbol given a count of at
+ *  least 1 so bytes the sample missed still get a code
+ * -letter counts for the HuffmanAlgorithm constructor
+ * -expected coding loss, and a bound on it at a given confidence
+ *
+ * Assumptions:
+ * -the coding loss is the extra bits per symbol a codebook built from
+ *  the estimate costs over one built from the exact counts. For small
+ *  errors it is close to a scaled chi-square with one degree of freedom
+ *  less than the number of symbols seen, whose mean comes from the
+ *  variance between the sampled chunks
+ * -the loss estimate treats the chunks as a random sample. Evenly
+ *  spaced chunks can line up with data that repeats with the same
+ *  period and miss more than the estimate says, so SAMPLE_RANDOM is
+ *  the default
+ * -the loss does not include the cost of the codes given to bytes that
+ *  were never seen
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "SampledHistogram.h"
+#include <cmath>
+#include <limits>
+#include <random>
+
+/**
+ * Overloaded constructor
+ * this function counts the bytes of one chunk from each stratum and
+ * scales the counts up to size. With a fraction of 1 or more every
+ * byte is counted and the counts are exact
+ * Preconditions: fraction must be above 0
+ * Postconditions: the estimated counts and coding loss are ready
+ * @param data: pointer to the input
+ * @param size: number of bytes
+ * @param fraction: fraction of the chunks to count
+ * @param mode: SAMPLE_EVEN or SAMPLE_RANDOM
+ * @param seed: seed for SAMPLE_RANDOM
+ */
+SampledHistogram::SampledHistogram(const uint8_t *data, size_t size,
+											  double fraction, SampleMode mode,
+											  uint64_t seed)
+{
+	size_t numChunks = (size + SAMPLE_CHUNK_SIZE - 1) / SAMPLE_CHUNK_SIZE;
+	size_t numSamples = numChunks;
+	if (fraction < 1)
+	{
+		numSamples = (size_t)ceil(numChunks * fraction);
+		if (numSamples < 1)
+		{
+			numSamples = 1;
+		}
+		if (numSamples > numChunks)
+		{
+			numSamples = numChunks;
+		}
+	}
+
+	if (numSamples == numChunks)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			counts_[data[i]]++;
+		}
+		sampledBytes_ = size;
+		exact_ = true;
+	}
+	else
+	{
+		// per symbol sums over the chunks, for the variance of the
+		// estimated probabilities
+		uint64_t chunkCount[NUM_BYTE_SYMBOLS] = {};
+		double sumSquares[NUM_BYTE_SYMBOLS] = {};
+		double sumCountSize[NUM_BYTE_SYMBOLS] = {};
+		double sumSizeSquares = 0;
+
+		mt19937_64 random(seed);
+		for (size_t j = 0; j < numSamples; j++)
+		{
+			size_t first = j * numChunks / numSamples;
+			size_t chunk = first;
+			if (mode == SAMPLE_RANDOM)
+			{
+				size_t last = (j + 1) * numChunks / numSamples;
+				chunk = first + random() % (last - first);
+			}
+			const uint8_t *begin = data + chunk * SAMPLE_CHUNK_SIZE;
+			size_t length = size - chunk * SAMPLE_CHUNK_SIZE;
+			if (length > SAMPLE_CHUNK_SIZE)
+			{
+				length = SAMPLE_CHUNK_SIZE;
+			}
+
+			for (size_t i = 0; i < length; i++)
+			{
+				chunkCount[begin[i]]++;
+			}
+			// visit each symbol of the chunk once, clearing it behind us
+			for (size_t i = 0; i < length; i++)
+			{
+				uint64_t c = chunkCount[begin[i]];
+				if (c > 0)
+				{
+					counts_[begin[i]] += c;
+					sumSquares[begin[i]] += (double)c * c;
+					sumCountSize[begin[i]] += (double)c * length;
+					chunkCount[begin[i]] = 0;
+				}
+			}
+			sumSizeSquares += (double)length * length;
+			sampledBytes_ += length;
+		}
+
+		// the loss of coding with probabilities off by e is close to
+		// the sum of e^2 / (2 p ln 2) over the symbols
+		double n = numSamples;
+		double meanSize = (double)sampledBytes_ / n;
+		double correction = 1 - n / numChunks;
+		expectedLoss_ = numSamples < 2 ? numeric_limits<double>::infinity() : 0;
+		for (int s = 0; s < NUM_BYTE_SYMBOLS && numSamples >= 2; s++)
+		{
+			if (counts_[s] == 0)
+			{
+				continue;
+			}
+			double p = (double)counts_[s] / sampledBytes_;
+			double deviation = sumSquares[s] - 2 * p * sumCountSize[s] +
+									 p * p * sumSizeSquares;
+			double variance = correction * deviation /
+									(n * (n - 1) * meanSize * meanSize);
+			expectedLoss_ += variance / (2 * p * log(2.0));
+		}
+
+		// scale up to the size of the input
+		double scale = (double)size / sampledBytes_;
+		for (int s = 0; s < NUM_BYTE_SYMBOLS; s++)
+		{
+			if (counts_[s] > 0)
+			{
+				degrees_++;
+				counts_[s] = (uint64_t)(counts_[s] * scale + 0.5);
+			}
+		}
+		degrees_--;
+	}
+
+	// bytes the sample missed still need a code
+	for (int s = 0; s < NUM_BYTE_SYMBOLS; s++)
+	{
+		if (counts_[s] == 0)
+		{
+			counts_[s] = 1;
+		}
+	}
+}
+
+const uint64_t *SampledHistogram::getCounts() const
+{
+	return counts_;
+}
+
+/**
+ * getLetterCounts
+ * this function copies the counts of 'a' to 'z', ready for the
+ * HuffmanAlgorithm constructor
+ * Preconditions: none
+ * Postconditions: counts holds the estimated count of each letter
+ * @param counts: 64 bit array the letter counts are copied to
+ */
+void SampledHistogram::getLetterCounts(uint64_t (&counts)[NUM_LETTERS]) const
+{
+	for (int i = 0; i < NUM_LETTERS; i++)
+	{
+		counts[i] = counts_['a' + i];
+	}
+}
+
+size_t SampledHistogram::getSampledBytes() const
+{
+	return sampledBytes_;
+}
+
+bool SampledHistogram::isExact() const
+{
+	return exact_;
+}
+
+double SampledHistogram::getExpectedLoss() const
+{
+	return expectedLoss_;
+}
+
+/**
+ * getLossBound
+ * this function bounds the coding loss with Cantelli's inequality,
+ * using the mean and variance of the scaled chi-square
+ * Preconditions: confidence must be between 0 and 1
+ * Postconditions: returns extra bits per symbol the loss stays
+ * under with probability of at least confidence
+ * @param confidence: probability the bound holds
+ * @return: bits per symbol
+ */
+double SampledHistogram::getLossBound(double confidence) const
+{
+	if (exact_ || degrees_ < 1)
+	{
+		return expectedLoss_;
+	}
+	// a chi-square with k degrees of freedom has mean k and variance
+	// 2k, so the loss has a standard deviation of mean * sqrt(2 / k)
+	double deviation = expectedLoss_ * sqrt(2.0 / degrees_);
+	return expectedLoss_ + deviation * sqrt(confidence / (1 - confidence));
+}
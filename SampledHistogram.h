@@ -0,0 +1,138 @@
+/*
+ * @file SampledHistogram.h
+ * @author Katarina McGaughy
+ * SampledHistogram class: The SampledHistogram class estimates the byte
+ * counts of a large input from a fraction of its cache line sized
+ * chunks, so a codebook can be chosen without reading every byte. The
+ * input is cut into as many equal strata as chunks to sample and one
+ * chunk is taken from each, either the first chunk of the stratum or
+ * a random one. The sampled counts are scaled up to the size of the
+ * input, so they can be used anywhere exact counts are.
+ *
+ * Features:
+ * -evenly spaced or random chunks, with a seed for repeatable results
+ * -counts scaled to the input size, every symbol given a count of at
+ *  least 1 so bytes the sample missed still get a code
+ * -letter counts for the HuffmanAlgorithm constructor
+ * -expected coding loss, and a bound on it at a given confidence
+ *
+ * Assumptions:
+ * -the coding loss is the extra bits per symbol a codebook built from
+ *  the estimate costs over one built from the exact counts. For small
+ *  errors it is close to a scaled chi-square with one degree of freedom
+ *  less than the number of symbols seen, whose mean comes from the
+ *  variance between the sampled chunks
+ * -the loss estimate treats the chunks as a random sample. Evenly
+ *  spaced chunks can line up with data that repeats with the same
+ *  period and miss more than the estimate says, so SAMPLE_RANDOM is
+ *  the default
+ * -the loss does not include the cost of the codes given to bytes that
+ *  were never seen
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Dictionary.h"
+#include "HuffmanAlgorithm.h"
+using namespace std;
+
+// bytes in each sampled chunk, one cache line
+const size_t SAMPLE_CHUNK_SIZE = 64;
+
+// fraction of the chunks counted by default
+const double DEFAULT_SAMPLE_FRACTION = 0.05;
+
+// how the chunk in each stratum is picked
+enum SampleMode
+{
+	SAMPLE_EVEN,
+	SAMPLE_RANDOM
+};
+
+class SampledHistogram
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * this function counts the bytes of one chunk from each stratum and
+	 * scales the counts up to size. With a fraction of 1 or more every
+	 * byte is counted and the counts are exact
+	 * Preconditions: fraction must be above 0
+	 * Postconditions: the estimated counts and coding loss are ready
+	 * @param data: pointer to the input
+	 * @param size: number of bytes
+	 * @param fraction: fraction of the chunks to count
+	 * @param mode: SAMPLE_EVEN or SAMPLE_RANDOM
+	 * @param seed: seed for SAMPLE_RANDOM
+	 */
+	SampledHistogram(const uint8_t *data, size_t size,
+						  double fraction = DEFAULT_SAMPLE_FRACTION,
+						  SampleMode mode = SAMPLE_RANDOM, uint64_t seed = 0);
+
+	/**
+	 * getCounts
+	 * Preconditions: none
+	 * Postconditions: returns the estimated count of each byte value,
+	 * NUM_BYTE_SYMBOLS entries that are all at least 1
+	 * @return: pointer to the counts
+	 */
+	const uint64_t *getCounts() const;
+
+	/**
+	 * getLetterCounts
+	 * this function copies the counts of 'a' to 'z', ready for the
+	 * HuffmanAlgorithm constructor
+	 * Preconditions: none
+	 * Postconditions: counts holds the estimated count of each letter
+	 * @param counts: 64 bit array the letter counts are copied to
+	 */
+	void getLetterCounts(uint64_t (&counts)[NUM_LETTERS]) const;
+
+	/**
+	 * getSampledBytes, isExact
+	 * Preconditions: none
+	 * Postconditions: return the number of bytes counted, and whether
+	 * every byte was counted
+	 */
+	size_t getSampledBytes() const;
+	bool isExact() const;
+
+	/**
+	 * getExpectedLoss
+	 * Preconditions: none
+	 * Postconditions: returns the expected extra bits per symbol from
+	 * coding with the estimated counts, 0 if the counts are exact
+	 * @return: bits per symbol
+	 */
+	double getExpectedLoss() const;
+
+	/**
+	 * getLossBound
+	 * this function bounds the coding loss with Cantelli's inequality,
+	 * using the mean and variance of the scaled chi-square
+	 * Preconditions: confidence must be between 0 and 1
+	 * Postconditions: returns extra bits per symbol the loss stays
+	 * under with probability of at least confidence
+	 * @param confidence: probability the bound holds
+	 * @return: bits per symbol
+	 */
+	double getLossBound(double confidence = 0.95) const;
+
+private:
+	uint64_t counts_[NUM_BYTE_SYMBOLS] = {};
+
+	size_t sampledBytes_ = 0;
+	bool exact_ = false;
+
+	double expectedLoss_ = 0;
+
+	// degrees of freedom of the chi-square the loss follows
+	int degrees_ = 0;
+};
@@ -0,0 +1,192 @@
+/*
+ * @file SeekIndex.cpp
+ * @author Katarina McGaughy
+ * SeekIndex class: The SeekIndex class records where every interval-th
+ * symbol starts in a packed code stream, so a range of symbols can be
+ * decoded from the nearest checkpoint instead of from the start. The
+ * time to read a range then depends on its length, not its offset.
+ *
+ * Features:
+ * -checkpoints of (symbol offset, bit offset), one every interval symbols
+ * -built from the symbols and code lengths, without decoding
+ * -decode any [begin, end) range of symbols
+ * -serialize the checkpoints as varint bit deltas
+ *
+ * Assumptions:
+ * -the stream was written with CodeTable::encode from its first bit
+ * -symbols fit in a byte
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "SeekIndex.h"
+#include "Varint.h"
+
+/**
+ * Overloaded constructor
+ * this function adds up the code lengths of data to find the bit
+ * offset of every interval-th symbol
+ * Preconditions: every byte of data must have a code in table,
+ * interval must be at least 1
+ * Postconditions: SeekIndex holds a checkpoint for symbol 0 and for
+ * every interval symbols after it
+ * @param table: CodeTable the stream is coded with
+ * @param data: pointer to the symbols that were encoded
+ * @param size: number of symbols
+ * @param interval: symbols between checkpoints
+ */
+SeekIndex::SeekIndex(const CodeTable &table, const uint8_t *data, size_t size,
+							size_t interval)
+	 : interval_(interval), numSymbols_(size)
+{
+	uint64_t bits = 0;
+	for (size_t i = 0; i < size; i++)
+	{
+		if (i % interval == 0)
+		{
+			bitOffsets_.push_back(bits);
+		}
+		bits += table.getLength(data[i]);
+	}
+	if (bitOffsets_.empty())
+	{
+		bitOffsets_.push_back(0);
+	}
+}
+
+size_t SeekIndex::getInterval() const
+{
+	return interval_;
+}
+
+size_t SeekIndex::getNumSymbols() const
+{
+	return numSymbols_;
+}
+
+size_t SeekIndex::getNumCheckpoints() const
+{
+	return bitOffsets_.size();
+}
+
+uint64_t SeekIndex::getBitOffset(size_t checkpoint) const
+{
+	return bitOffsets_[checkpoint];
+}
+
+/**
+ * decodeRange
+ * this function seeks to the last checkpoint at or before begin,
+ * skips the symbols up to begin and decodes symbols begin to end - 1
+ * Preconditions: table must be the CodeTable the stream is coded with
+ * Postconditions: the symbols are appended to out, returns false if
+ * the range is past the end or the data ends early
+ * @param table: CodeTable the stream is coded with
+ * @param data: pointer to the first byte of the packed codes
+ * @param size: number of bytes available
+ * @param begin: first symbol to decode
+ * @param end: one past the last symbol to decode
+ * @param out: vector the symbols are appended to
+ * @return: true if the range was decoded
+ */
+bool SeekIndex::decodeRange(const CodeTable &table, const uint8_t *data,
+									 size_t size, size_t begin, size_t end,
+									 vector<uint8_t> &out) const
+{
+	if (begin > end || end > numSymbols_)
+	{
+		return false;
+	}
+	if (begin == end)
+	{
+		return true;
+	}
+	size_t checkpoint = begin / interval_;
+	BitReader in(data, size, bitOffsets_[checkpoint]);
+
+	// skip to begin, at most interval_ - 1 symbols
+	for (size_t i = checkpoint * interval_; i < begin; i++)
+	{
+		if (table.decodeSymbol(in) < 0)
+		{
+			return false;
+		}
+	}
+	return table.decode(in, end - begin, out);
+}
+
+/**
+ * serialize
+ * this function writes the interval, the number of symbols and the
+ * bit distance between neighbouring checkpoints as varints
+ * Preconditions: none
+ * Postconditions: the bytes are appended to out
+ * @param out: vector the bytes are appended to
+ */
+void SeekIndex::serialize(vector<uint8_t> &out) const
+{
+	writeVarint(interval_, out);
+	writeVarint(numSymbols_, out);
+	for (size_t i = 1; i < bitOffsets_.size(); i++)
+	{
+		writeVarint(bitOffsets_[i] - bitOffsets_[i - 1], out);
+	}
+}
+
+/**
+ * deserialize
+ * Preconditions: none
+ * Postconditions: returns the SeekIndex, or nullptr if the bytes are
+ * malformed
+ * @param data: pointer to the serialized index
+ * @param size: number of bytes available
+ * @param used: set to the number of bytes read
+ * @return: the SeekIndex or nullptr
+ */
+shared_ptr<const SeekIndex> SeekIndex::deserialize(const uint8_t *data,
+																	size_t size, size_t &used)
+{
+	shared_ptr<SeekIndex> index(new SeekIndex());
+	size_t pos = 0;
+	uint64_t interval = 0;
+	uint64_t numSymbols = 0;
+	size_t n = readVarint(data, size, interval);
+	if (n == 0 || interval == 0)
+	{
+		return nullptr;
+	}
+	pos += n;
+	n = readVarint(data + pos, size - pos, numSymbols);
+	if (n == 0)
+	{
+		return nullptr;
+	}
+	pos += n;
+	index->interval_ = interval;
+	index->numSymbols_ = numSymbols;
+
+	// one checkpoint for symbol 0 and each interval after it
+	uint64_t numCheckpoints = numSymbols == 0 ? 1 : (numSymbols - 1) / interval + 1;
+	// every delta takes at least one byte
+	if (numCheckpoints - 1 > size - pos)
+	{
+		return nullptr;
+	}
+	index->bitOffsets_.push_back(0);
+	for (uint64_t i = 1; i < numCheckpoints; i++)
+	{
+		uint64_t delta = 0;
+		n = readVarint(data + pos, size - pos, delta);
+		if (n == 0)
+		{
+			return nullptr;
+		}
+		pos += n;
+		index->bitOffsets_.push_back(index->bitOffsets_.back() + delta);
+	}
+	used = pos;
+	return index;
+}
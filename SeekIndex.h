@@ -0,0 +1,129 @@
+/*
+ * @file SeekIndex.h
+ * @author Katarina McGaughy
+ * SeekIndex class: The SeekIndex class records where every interval-th
+ * symbol starts in a packed code stream, so a range of symbols can be
+ * decoded from the nearest checkpoint instead of from the start. The
+ * time to read a range then depends on its length, not its offset.
+ *
+ * Features:
+ * -checkpoints of (symbol offset, bit offset), one every interval symbols
+ * -built from the symbols and code lengths, without decoding
+ * -decode any [begin, end) range of symbols
+ * -serialize the checkpoints as varint bit deltas
+ *
+ * Assumptions:
+ * -the stream was written with CodeTable::encode from its first bit
+ * -symbols fit in a byte
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "CodeTable.h"
+using namespace std;
+
+// symbols between checkpoints
+const size_t DEFAULT_CHECKPOINT_INTERVAL = 1024;
+
+class SeekIndex
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * this function adds up the code lengths of data to find the bit
+	 * offset of every interval-th symbol
+	 * Preconditions: every byte of data must have a code in table,
+	 * interval must be at least 1
+	 * Postconditions: SeekIndex holds a checkpoint for symbol 0 and for
+	 * every interval symbols after it
+	 * @param table: CodeTable the stream is coded with
+	 * @param data: pointer to the symbols that were encoded
+	 * @param size: number of symbols
+	 * @param interval: symbols between checkpoints
+	 */
+	SeekIndex(const CodeTable &table, const uint8_t *data, size_t size,
+				 size_t interval = DEFAULT_CHECKPOINT_INTERVAL);
+
+	/**
+	 * getInterval, getNumSymbols, getNumCheckpoints
+	 * Preconditions: none
+	 * Postconditions: return the symbols between checkpoints, the symbols
+	 * in the stream and the number of checkpoints
+	 */
+	size_t getInterval() const;
+	size_t getNumSymbols() const;
+	size_t getNumCheckpoints() const;
+
+	/**
+	 * getBitOffset
+	 * Preconditions: checkpoint must be below getNumCheckpoints()
+	 * Postconditions: returns the bit offset of symbol
+	 * checkpoint * getInterval()
+	 * @param checkpoint: index of the checkpoint
+	 * @return: bit offset from the start of the stream
+	 */
+	uint64_t getBitOffset(size_t checkpoint) const;
+
+	/**
+	 * decodeRange
+	 * this function seeks to the last checkpoint at or before begin,
+	 * skips the symbols up to begin and decodes symbols begin to end - 1
+	 * Preconditions: table must be the CodeTable the stream is coded with
+	 * Postconditions: the symbols are appended to out, returns false if
+	 * the range is past the end or the data ends early
+	 * @param table: CodeTable the stream is coded with
+	 * @param data: pointer to the first byte of the packed codes
+	 * @param size: number of bytes available
+	 * @param begin: first symbol to decode
+	 * @param end: one past the last symbol to decode
+	 * @param out: vector the symbols are appended to
+	 * @return: true if the range was decoded
+	 */
+	bool decodeRange(const CodeTable &table, const uint8_t *data, size_t size,
+						  size_t begin, size_t end, vector<uint8_t> &out) const;
+
+	/**
+	 * serialize
+	 * this function writes the interval, the number of symbols and the
+	 * bit distance between neighbouring checkpoints as varints
+	 * Preconditions: none
+	 * Postconditions: the bytes are appended to out
+	 * @param out: vector the bytes are appended to
+	 */
+	void serialize(vector<uint8_t> &out) const;
+
+	/**
+	 * deserialize
+	 * Preconditions: none
+	 * Postconditions: returns the SeekIndex, or nullptr if the bytes are
+	 * malformed
+	 * @param data: pointer to the serialized index
+	 * @param size: number of bytes available
+	 * @param used: set to the number of bytes read
+	 * @return: the SeekIndex or nullptr
+	 */
+	static shared_ptr<const SeekIndex> deserialize(const uint8_t *data,
+																  size_t size, size_t &used);
+
+private:
+	/**
+	 * default constructor, used by deserialize
+	 */
+	SeekIndex() {}
+
+	size_t interval_ = DEFAULT_CHECKPOINT_INTERVAL;
+
+	size_t numSymbols_ = 0;
+
+	// bit offset of symbol i * interval_, entry 0 is always 0
+	vector<uint64_t> bitOffsets_;
+};
@@ -0,0 +1,105 @@
+/*
+ * @file SharedCodeTable.cpp
+ * @author Katarina McGaughy
+ * SharedCodeTable class: The SharedCodeTable class publishes the current
+ * CodeTable to every encoding thread. A new version is rolled out by
+ * swapping an atomic pointer, and threads holding the old version keep
+ * using it until they let it go.
+ *
+ * Features:
+ * -publish a new CodeTable with an atomic pointer swap
+ * -load the current CodeTable
+ * -Reader that caches the current CodeTable per thread and only reloads
+ *  it when the version changes
+ *
+ * Assumptions:
+ * -a Reader belongs to a single thread
+ * -the SharedCodeTable outlives its Readers
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "SharedCodeTable.h"
+
+/**
+ * constructor
+ * Preconditions: table must not be nullptr
+ * Postconditions: table is published as version 1
+ * @param table: first CodeTable to publish
+ */
+SharedCodeTable::SharedCodeTable(shared_ptr<const CodeTable> table)
+{
+	publish(table);
+}
+
+/**
+ * publish
+ * this function swaps in a new CodeTable. Encoders pick it up on
+ * their next call without waiting on each other
+ * Preconditions: table must not be nullptr
+ * Postconditions: table is the current version
+ * @param table: CodeTable to publish
+ */
+void SharedCodeTable::publish(shared_ptr<const CodeTable> table)
+{
+	table_.store(table, memory_order_release);
+	// bump the version after the store so a Reader that sees the new
+	// version also sees the new table
+	version_.fetch_add(1, memory_order_release);
+}
+
+/**
+ * load
+ * Preconditions: none
+ * Postconditions: returns the current CodeTable
+ * @return: the current CodeTable
+ */
+shared_ptr<const CodeTable> SharedCodeTable::load() const
+{
+	return table_.load(memory_order_acquire);
+}
+
+/**
+ * getVersion
+ * Preconditions: none
+ * Postconditions: returns how many tables have been published
+ * @return: current version number
+ */
+uint64_t SharedCodeTable::getVersion() const
+{
+	return version_.load(memory_order_acquire);
+}
+
+/**
+ * Reader constructor
+ * Preconditions: shared must outlive the Reader
+ * Postconditions: Reader holds the current CodeTable
+ * @param shared: SharedCodeTable to read from
+ */
+SharedCodeTable::Reader::Reader(const SharedCodeTable &shared)
+	: shared_(shared), version_(shared.getVersion())
+{
+	table_ = shared_.load();
+}
+
+/**
+ * get
+ * this function reloads the CodeTable if a new version was
+ * published since the last call and returns it
+ * Preconditions: none
+ * Postconditions: returns the current CodeTable
+ * @return: the current CodeTable
+ */
+const CodeTable &SharedCodeTable::Reader::get()
+{
+	uint64_t version = shared_.getVersion();
+	if (version != version_)
+	{
+		version_ = version;
+		table_ = shared_.load();
+	}
+	return *table_;
+}
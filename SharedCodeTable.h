@@ -0,0 +1,108 @@
+/*
+ * @file SharedCodeTable.h
+ * @author Katarina McGaughy
+ * SharedCodeTable class: The SharedCodeTable class publishes the current
+ * CodeTable to every encoding thread. A new version is rolled out by
+ * swapping an atomic pointer, and threads holding the old version keep
+ * using it until they let it go.
+ *
+ * Features:
+ * -publish a new CodeTable with an atomic pointer swap
+ * -load the current CodeTable
+ * -Reader that caches the current CodeTable per thread and only reloads
+ *  it when the version changes
+ *
+ * Assumptions:
+ * -a Reader belongs to a single thread
+ * -the SharedCodeTable outlives its Readers
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "CodeTable.h"
+using namespace std;
+
+class SharedCodeTable
+{
+public:
+	/**
+	 * constructor
+	 * Preconditions: table must not be nullptr
+	 * Postconditions: table is published as version 1
+	 * @param table: first CodeTable to publish
+	 */
+	explicit SharedCodeTable(shared_ptr<const CodeTable> table);
+
+	/**
+	 * publish
+	 * this function swaps in a new CodeTable. Encoders pick it up on
+	 * their next call without waiting on each other
+	 * Preconditions: table must not be nullptr
+	 * Postconditions: table is the current version
+	 * @param table: CodeTable to publish
+	 */
+	void publish(shared_ptr<const CodeTable> table);
+
+	/**
+	 * load
+	 * Preconditions: none
+	 * Postconditions: returns the current CodeTable
+	 * @return: the current CodeTable
+	 */
+	shared_ptr<const CodeTable> load() const;
+
+	/**
+	 * getVersion
+	 * Preconditions: none
+	 * Postconditions: returns how many tables have been published
+	 * @return: current version number
+	 */
+	uint64_t getVersion() const;
+
+	/**
+	 * Reader class keeps one thread's copy of the current CodeTable.
+	 * get() only compares version numbers in the common case, so
+	 * encoding threads never wait on a publish or on each other
+	 */
+	class Reader
+	{
+	public:
+		/**
+		 * constructor
+		 * Preconditions: shared must outlive the Reader
+		 * Postconditions: Reader holds the current CodeTable
+		 * @param shared: SharedCodeTable to read from
+		 */
+		explicit Reader(const SharedCodeTable &shared);
+
+		/**
+		 * get
+		 * this function reloads the CodeTable if a new version was
+		 * published since the last call and returns it
+		 * Preconditions: none
+		 * Postconditions: returns the current CodeTable
+		 * @return: the current CodeTable
+		 */
+		const CodeTable &get();
+
+	private:
+		const SharedCodeTable &shared_;
+		shared_ptr<const CodeTable> table_;
+		uint64_t version_;
+	};
+
+private:
+	// current table
+	atomic<shared_ptr<const CodeTable>> table_;
+
+	// incremented after every publish
+	atomic<uint64_t> version_{0};
+};
@@ -0,0 +1,292 @@
+/*
+ * @file StaticCodebook.h
+ * @author Katarina McGaughy
+ * StaticCodebook class: The StaticCodebook class builds a codebook
+ * entirely at compile time from a constexpr frequency table, such as
+ * the letter counts HW2.cpp uses. The code lengths, canonical codes
+ * and decode table are all constexpr, so encoding with a fixed table
+ * does no heap, tree or console work at startup.
+ *
+ * Features:
+ * -constexpr Huffman code lengths, limited to maxLength
+ * -constexpr canonical codes (same codes as CodeTable::fromLengths)
+ * -constexpr decode table (flattened binary trie)
+ * -getWord and decode like CodeTable
+ * -toCodeTable for code that needs a shared CodeTable
+ *
+ * Assumptions:
+ * -N symbols are the characters FirstSymbol, FirstSymbol + 1, ...
+ * -the template is declared and defined here (like PriorityQueue)
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "CodebookHeader.h"
+#include "CodeTable.h"
+#include "HuffmanAlgorithm.h"
+using namespace std;
+
+template <int N, char FirstSymbol = 'a'>
+class StaticCodebook
+{
+public:
+	/**
+	 * constructor
+	 * this function merges the two lightest nodes until one is left,
+	 * reads each symbol's code length from its depth, limits the
+	 * lengths and assigns canonical codes. Symbols with a count of 0
+	 * get no code. Ties go to the node created first, so the result
+	 * only depends on counts
+	 * Preconditions: counts must have N entries
+	 * Postconditions: all tables are filled
+	 * @param counts: 64 bit frequencies for each symbol
+	 * @param maxLength: longest code length allowed
+	 */
+	constexpr StaticCodebook(const uint64_t (&counts)[N],
+									 int maxLength = MAX_HEADER_CODE_LENGTH)
+	{
+		// leaves first, then one merged node per merge
+		uint64_t weight[2 * N] = {};
+		int parent[2 * N] = {};
+		bool merged[2 * N] = {};
+		int leaf[N] = {};
+		int numNodes = 0;
+		for (int i = 0; i < N; i++)
+		{
+			lengths_[i] = 0;
+			codes_[i] = 0;
+			leaf[i] = -1;
+			if (counts[i] > 0)
+			{
+				leaf[i] = numNodes;
+				weight[numNodes++] = counts[i];
+			}
+		}
+
+		int active = numNodes;
+		while (active > 1)
+		{
+			int first = -1;
+			int second = -1;
+			for (int j = 0; j < numNodes; j++)
+			{
+				if (merged[j])
+				{
+					continue;
+				}
+				if (first < 0 || weight[j] < weight[first])
+				{
+					second = first;
+					first = j;
+				}
+				else if (second < 0 || weight[j] < weight[second])
+				{
+					second = j;
+				}
+			}
+			merged[first] = true;
+			merged[second] = true;
+			parent[first] = numNodes;
+			parent[second] = numNodes;
+			weight[numNodes++] = weight[first] + weight[second];
+			active--;
+		}
+
+		// parents are always created after their children
+		int depth[2 * N] = {};
+		for (int j = numNodes - 2; j >= 0; j--)
+		{
+			depth[j] = depth[parent[j]] + 1;
+		}
+		for (int i = 0; i < N; i++)
+		{
+			if (leaf[i] >= 0)
+			{
+				lengths_[i] = numNodes == 1 ? 1 : depth[leaf[i]];
+			}
+		}
+		HuffmanAlgorithm::limitCodeLengths(counts, N, maxLength, lengths_);
+
+		assignCanonicalCodes();
+		buildDecodeTable();
+	}
+
+	/**
+	 * getLength
+	 * Preconditions: symbol must be between 0 and N - 1
+	 * Postconditions: returns the code length of symbol, 0 if none
+	 */
+	constexpr int getLength(int symbol) const
+	{
+		return lengths_[symbol];
+	}
+
+	/**
+	 * getBits
+	 * Preconditions: symbol must be between 0 and N - 1
+	 * Postconditions: returns the code of symbol, right aligned
+	 */
+	constexpr uint32_t getBits(int symbol) const
+	{
+		return codes_[symbol];
+	}
+
+	/**
+	 * decodeStep
+	 * this function follows one bit through the decode table
+	 * Preconditions: node must be 0 or a value returned by decodeStep
+	 * Postconditions: returns the next node, or -(symbol + 1) once the
+	 * bit completes a code
+	 * @param node: current node, 0 at the start of a code
+	 * @param bit: 0 or 1
+	 * @return: next node or -(symbol + 1)
+	 */
+	constexpr int decodeStep(int node, int bit) const
+	{
+		return decode_[node][bit];
+	}
+
+	/**
+	 * getWord
+	 * this funtion takes in a string and then returns the
+	 * code for that string, skipping characters outside the alphabet
+	 * Preconditions: none
+	 * PostConditions: returns the code for the string entered
+	 */
+	string getWord(const string &in) const
+	{
+		string code = "";
+		for (char c : in)
+		{
+			int symbol = (unsigned char)c - (unsigned char)FirstSymbol;
+			if (symbol < 0 || symbol >= N)
+			{
+				continue;
+			}
+			for (int j = lengths_[symbol] - 1; j >= 0; j--)
+			{
+				code += (char)('0' + ((codes_[symbol] >> j) & 1));
+			}
+		}
+		return code;
+	}
+
+	/**
+	 * decode
+	 * this function takes in a string of 0s and 1s produced by getWord
+	 * and walks the decode table to recover the characters
+	 * Preconditions: none
+	 * PostConditions: returns the decoded characters
+	 */
+	string decode(const string &bits) const
+	{
+		string word = "";
+		int node = 0;
+		for (char bit : bits)
+		{
+			node = decodeStep(node, bit - '0');
+			if (node < 0)
+			{
+				word += (char)(FirstSymbol + (-node - 1));
+				node = 0;
+			}
+		}
+		return word;
+	}
+
+	/**
+	 * toCodeTable
+	 * Preconditions: none
+	 * Postconditions: returns a CodeTable with the same codes, for
+	 * sharing through a SharedCodeTable or CodebookCache
+	 */
+	shared_ptr<const CodeTable> toCodeTable() const
+	{
+		return CodeTable::fromLengths(lengths_, N, FirstSymbol);
+	}
+
+private:
+	// code length of each symbol
+	int lengths_[N] = {};
+
+	// canonical code of each symbol, right aligned
+	uint32_t codes_[N] = {};
+
+	// decode trie, entry 0 is the root, negative entries are symbols
+	int decode_[N][2] = {};
+
+	/**
+	 * assignCanonicalCodes
+	 * this function hands out codes in order of length, then symbol
+	 * Preconditions: lengths_ must form a prefix code
+	 * Postconditions: codes_ holds the canonical code of each symbol
+	 */
+	constexpr void assignCanonicalCodes()
+	{
+		uint32_t lengthCount[33] = {};
+		for (int i = 0; i < N; i++)
+		{
+			lengthCount[lengths_[i]]++;
+		}
+		lengthCount[0] = 0;
+		uint32_t nextCode[33] = {};
+		uint32_t code = 0;
+		for (int len = 1; len <= 32; len++)
+		{
+			code = (code + lengthCount[len - 1]) << 1;
+			nextCode[len] = code;
+		}
+		for (int i = 0; i < N; i++)
+		{
+			if (lengths_[i] > 0)
+			{
+				codes_[i] = nextCode[lengths_[i]]++;
+			}
+		}
+	}
+
+	/**
+	 * buildDecodeTable
+	 * this function inserts every code into the decode trie
+	 * Preconditions: codes_ must be assigned
+	 * Postconditions: decode_ maps every code back to its symbol
+	 */
+	constexpr void buildDecodeTable()
+	{
+		int numEntries = 1;
+		for (int i = 0; i < N; i++)
+		{
+			int node = 0;
+			for (int j = lengths_[i] - 1; j >= 0; j--)
+			{
+				int bit = (codes_[i] >> j) & 1;
+				if (j == 0)
+				{
+					decode_[node][bit] = -(i + 1);
+				}
+				else
+				{
+					if (decode_[node][bit] <= 0)
+					{
+						decode_[node][bit] = numEntries++;
+					}
+					node = decode_[node][bit];
+				}
+			}
+		}
+	}
+};
+
+// relative frequency of each letter in English text, per 100000 letters
+constexpr uint64_t ENGLISH_LETTER_COUNTS[NUM_LETTERS] = {
+	8167, 1492, 2782, 4253, 12702, 2228, 2015, 6094, 6966, 153, 772, 4025,
+	2406, 6749, 7507, 1929, 95, 5987, 6327, 9056, 2758, 978, 2360, 150,
+	1974, 74};
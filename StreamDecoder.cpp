@@ -0,0 +1,138 @@
+/*
+ * @file StreamDecoder.cpp
+ * @author Katarina McGaughy
+ * StreamDecoder class: The StreamDecoder class decodes a packed code
+ * stream that arrives in chunks, such as reads from a socket, where a
+ * chunk can end in the middle of a code. Its position in the decode
+ * table and any bits it has not used yet are kept between calls to
+ * feed, so the caller never has to buffer a whole message.
+ *
+ * Features:
+ * -resumes a code that was split between chunks
+ * -writes into a caller supplied output buffer of any size, and stops
+ *  when it is full
+ * -reports how many input bytes it consumed, so the caller can hold the
+ *  rest back until there is room for more output
+ * -constant memory, whatever the message size
+ *
+ * Assumptions:
+ * -the number of symbols in the stream is known up front, as it is in
+ *  a BlockCodec block, so the padding bits at the end are not decoded
+ * -symbols fit in a byte
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "StreamDecoder.h"
+
+/**
+ * Overloaded constructor
+ * Preconditions: table must not be nullptr
+ * Postconditions: StreamDecoder is at the start of a stream of
+ * numSymbols symbols coded with table
+ * @param table: CodeTable the stream is coded with
+ * @param numSymbols: number of symbols in the stream
+ */
+StreamDecoder::StreamDecoder(shared_ptr<const CodeTable> table,
+									  uint64_t numSymbols)
+	 : table_(table), symbolsLeft_(numSymbols)
+{
+}
+
+/**
+ * feed
+ * this function decodes the bits left from the last call, then the
+ * bytes of data, until the output buffer is full, data runs out or
+ * the stream is done. A byte is consumed once any of its bits are
+ * used; its unused bits are kept for the next call
+ * Preconditions: none
+ * Postconditions: returns the number of bytes of data consumed, the
+ * caller passes the rest again in the next call
+ * @param data: pointer to the next bytes of the stream
+ * @param size: number of bytes available
+ * @param out: buffer the decoded symbols are written to
+ * @param capacity: size of out
+ * @param written: set to the number of symbols written to out
+ * @return: number of bytes consumed
+ */
+size_t StreamDecoder::feed(const uint8_t *data, size_t size, uint8_t *out,
+									size_t capacity, size_t &written)
+{
+	written = 0;
+	if (pendingCount_ > 0)
+	{
+		int used = decodeBits(pending_, pendingCount_, out, capacity, written);
+		pending_ <<= used;
+		pendingCount_ -= used;
+		if (pendingCount_ > 0 && !isDone())
+		{
+			return 0;
+		}
+		// padding after the last code is dropped
+		pendingCount_ = 0;
+	}
+
+	size_t consumed = 0;
+	while (consumed < size && written < capacity && !isDone() && !error_)
+	{
+		uint8_t bits = data[consumed++];
+		int used = decodeBits(bits, 8, out, capacity, written);
+		if (used < 8 && !isDone())
+		{
+			pending_ = bits << used;
+			pendingCount_ = 8 - used;
+			break;
+		}
+	}
+	return consumed;
+}
+
+/**
+ * decodeBits
+ * this function decodes the top count bits of bits
+ * Preconditions: count must be between 0 and 8
+ * Postconditions: returns the number of bits used, fewer than count
+ * if out filled up, the stream ended or a bit was invalid
+ */
+int StreamDecoder::decodeBits(uint8_t bits, int count, uint8_t *out,
+										size_t capacity, size_t &written)
+{
+	for (int i = 0; i < count; i++)
+	{
+		if (written == capacity || symbolsLeft_ == 0 || error_)
+		{
+			return i;
+		}
+		node_ = table_->decodeStep(node_, (bits >> (7 - i)) & 1);
+		if (node_ < 0)
+		{
+			out[written++] = (uint8_t)(-node_ - 1);
+			symbolsLeft_--;
+			node_ = 0;
+		}
+		else if (node_ == 0)
+		{
+			error_ = true;
+			return i;
+		}
+	}
+	return count;
+}
+
+bool StreamDecoder::isDone() const
+{
+	return symbolsLeft_ == 0;
+}
+
+bool StreamDecoder::hasError() const
+{
+	return error_;
+}
+
+uint64_t StreamDecoder::getSymbolsLeft() const
+{
+	return symbolsLeft_;
+}
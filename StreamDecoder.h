@@ -0,0 +1,103 @@
+/*
+ * @file StreamDecoder.h
+ * @author Katarina McGaughy
+ * StreamDecoder class: The StreamDecoder class decodes a packed code
+ * stream that arrives in chunks, such as reads from a socket, where a
+ * chunk can end in the middle of a code. Its position in the decode
+ * table and any bits it has not used yet are kept between calls to
+ * feed, so the caller never has to buffer a whole message.
+ *
+ * Features:
+ * -resumes a code that was split between chunks
+ * -writes into a caller supplied output buffer of any size, and stops
+ *  when it is full
+ * -reports how many input bytes it consumed, so the caller can hold the
+ *  rest back until there is room for more output
+ * -constant memory, whatever the message size
+ *
+ * Assumptions:
+ * -the number of symbols in the stream is known up front, as it is in
+ *  a BlockCodec block, so the padding bits at the end are not decoded
+ * -symbols fit in a byte
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "CodeTable.h"
+using namespace std;
+
+class StreamDecoder
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * Preconditions: table must not be nullptr
+	 * Postconditions: StreamDecoder is at the start of a stream of
+	 * numSymbols symbols coded with table
+	 * @param table: CodeTable the stream is coded with
+	 * @param numSymbols: number of symbols in the stream
+	 */
+	StreamDecoder(shared_ptr<const CodeTable> table, uint64_t numSymbols);
+
+	/**
+	 * feed
+	 * this function decodes the bits left from the last call, then the
+	 * bytes of data, until the output buffer is full, data runs out or
+	 * the stream is done. A byte is consumed once any of its bits are
+	 * used; its unused bits are kept for the next call
+	 * Preconditions: none
+	 * Postconditions: returns the number of bytes of data consumed, the
+	 * caller passes the rest again in the next call
+	 * @param data: pointer to the next bytes of the stream
+	 * @param size: number of bytes available
+	 * @param out: buffer the decoded symbols are written to
+	 * @param capacity: size of out
+	 * @param written: set to the number of symbols written to out
+	 * @return: number of bytes consumed
+	 */
+	size_t feed(const uint8_t *data, size_t size, uint8_t *out, size_t capacity,
+					size_t &written);
+
+	/**
+	 * isDone, hasError, getSymbolsLeft
+	 * Preconditions: none
+	 * Postconditions: return true once every symbol has been decoded,
+	 * true if the stream held a bit pattern that is not a code, and the
+	 * number of symbols still to decode
+	 */
+	bool isDone() const;
+	bool hasError() const;
+	uint64_t getSymbolsLeft() const;
+
+private:
+	/**
+	 * decodeBits
+	 * this function decodes the top count bits of bits
+	 * Preconditions: count must be between 0 and 8
+	 * Postconditions: returns the number of bits used, fewer than count
+	 * if out filled up, the stream ended or a bit was invalid
+	 */
+	int decodeBits(uint8_t bits, int count, uint8_t *out, size_t capacity,
+						size_t &written);
+
+	shared_ptr<const CodeTable> table_;
+
+	uint64_t symbolsLeft_;
+
+	// position in the decode table, 0 between codes
+	int node_ = 0;
+
+	// bits of the last consumed byte not yet decoded, top aligned
+	uint8_t pending_ = 0;
+	int pendingCount_ = 0;
+
+	bool error_ = false;
+};
@@ -0,0 +1,476 @@
+/*
+ * @file TokenCodebook.cpp
+ * @author Katarina McGaughy
+ * TokenCodebook class: The TokenCodebook class codes whole tokens
+ * instead of single letters. Text is split into tokens, each token is
+ * interned into a dense ID with a TokenTable, and the ID counts drive
+ * the codebook, so a common word costs a few bits in total instead of
+ * a few bits per letter. Separator bytes (spaces, punctuation, field
+ * delimiters) are tokens of their own, so no text is lost.
+ *
+ * Features:
+ * -word tokens (runs of letters and digits) or delimiter separated
+ *  fields
+ * -vocabulary of the most frequent tokens, built with
+ *  HuffmanAlgorithm::buildCodeLengthsSorted so it scales to millions of
+ *  tokens
+ * -tokens outside the vocabulary are sent as an escape code followed by
+ *  their bytes, spelled with a byte codebook and an end of token code
+ * -getWord and decode on strings of 0s and 1s, like CodeTable
+ * -serialize the vocabulary and both codebooks
+ *
+ * Assumptions:
+ * -tokens longer than MAX_TOKEN_LENGTH bytes are split
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "TokenCodebook.h"
+#include <algorithm>
+#include <cctype>
+#include "CodebookHeader.h"
+#include "HuffmanAlgorithm.h"
+#include "Varint.h"
+
+// symbol of the spelling codebook that ends an escaped token
+static const int TOKEN_END = 256;
+
+/**
+ * Overloaded constructor
+ * this function splits sample into tokens, counts them, keeps the
+ * maxVocabulary most frequent tokens seen at least minTokenCount
+ * times and builds the token codebook and the spelling codebook
+ * for escaped tokens
+ * PreConditions: separators must have 256 entries
+ * PostConditions: TokenCodebook is ready to encode and decode
+ * @param sample: pointer to the training text
+ * @param size: number of bytes
+ * @param separators: true for each byte value that is a token of its
+ * own and ends the token before it
+ * @param maxVocabulary: most tokens kept
+ * @param minTokenCount: fewest times a token must be seen to be kept
+ */
+TokenCodebook::TokenCodebook(const uint8_t *sample, size_t size,
+									  const vector<bool> &separators,
+									  int maxVocabulary, int minTokenCount)
+	 : separators_(separators)
+{
+	// count every distinct token
+	TokenTable seen;
+	vector<uint64_t> counts;
+	for (size_t pos = 0; pos < size;)
+	{
+		size_t length = tokenLength(sample + pos, size - pos);
+		int id = seen.intern(sample + pos, length);
+		if (id == (int)counts.size())
+		{
+			counts.push_back(0);
+		}
+		counts[id]++;
+		pos += length;
+	}
+
+	// most frequent first, first seen first on ties
+	vector<int> order(counts.size());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	stable_sort(order.begin(), order.end(), [&counts](int a, int b)
+					{ return counts[a] > counts[b]; });
+
+	// the rest are escaped, and their bytes train the spelling codebook
+	vector<uint64_t> tokenCounts;
+	uint64_t spellingCounts[TOKEN_END + 1];
+	fill(spellingCounts, spellingCounts + TOKEN_END + 1, 1);
+	uint64_t escapes = 1;
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		int id = order[i];
+		if ((int)i < maxVocabulary && counts[id] >= (uint64_t)minTokenCount)
+		{
+			const string &token = seen.getToken(id);
+			vocabulary_.intern((const uint8_t *)token.data(), token.size());
+			tokenCounts.push_back(counts[id]);
+		}
+		else
+		{
+			escapes += counts[id];
+			for (unsigned char c : seen.getToken(id))
+			{
+				spellingCounts[c] += counts[id];
+			}
+			spellingCounts[TOKEN_END] += counts[id];
+		}
+	}
+	tokenCounts.push_back(escapes);
+
+	vector<int> lengths(tokenCounts.size());
+	HuffmanAlgorithm::buildCodeLengthsSorted(tokenCounts.data(),
+														  tokenCounts.size(),
+														  MAX_TOKEN_CODE_LENGTH,
+														  lengths.data());
+	tokens_ = CodeTable::fromLengths(lengths.data(), lengths.size(), 0);
+
+	int spellingLengths[TOKEN_END + 1];
+	HuffmanAlgorithm::buildCodeLengths(spellingCounts, TOKEN_END + 1,
+												  MAX_HEADER_CODE_LENGTH, spellingLengths);
+	spelling_ = CodeTable::fromLengths(spellingLengths, TOKEN_END + 1, 0);
+}
+
+/**
+ * wordSeparators
+ * Preconditions: none
+ * Postconditions: returns separators that make words of letters and
+ * digits, every other byte is a token of its own
+ * @return: separator flag of each byte value
+ */
+vector<bool> TokenCodebook::wordSeparators()
+{
+	vector<bool> separators(256);
+	for (int i = 0; i < 256; i++)
+	{
+		separators[i] = !(i < 128 && isalnum(i));
+	}
+	return separators;
+}
+
+/**
+ * fieldSeparators
+ * Preconditions: none
+ * Postconditions: returns separators that make fields of everything
+ * between delimiter and newline bytes
+ * @param delimiter: byte between fields, such as ',' or '\t'
+ * @return: separator flag of each byte value
+ */
+vector<bool> TokenCodebook::fieldSeparators(char delimiter)
+{
+	vector<bool> separators(256, false);
+	separators[(unsigned char)delimiter] = true;
+	separators['\n'] = true;
+	separators['\r'] = true;
+	return separators;
+}
+
+/**
+ * tokenLength
+ * Preconditions: size must be at least 1
+ * Postconditions: returns the length of the token at the start of
+ * data
+ */
+size_t TokenCodebook::tokenLength(const uint8_t *data, size_t size) const
+{
+	if (separators_[data[0]])
+	{
+		return 1;
+	}
+	size_t length = 1;
+	while (length < size && length < MAX_TOKEN_LENGTH &&
+			 !separators_[data[length]])
+	{
+		length++;
+	}
+	return length;
+}
+
+/**
+ * encode
+ * Preconditions: none
+ * Postconditions: the codes for the tokens of data are written to out
+ * @param data: pointer to the text
+ * @param size: number of bytes
+ * @param out: BitWriter the codes are written to
+ */
+void TokenCodebook::encode(const uint8_t *data, size_t size,
+									BitWriter &out) const
+{
+	int escape = vocabulary_.size();
+	for (size_t pos = 0; pos < size;)
+	{
+		size_t length = tokenLength(data + pos, size - pos);
+		int id = vocabulary_.find(data + pos, length);
+		if (id >= 0)
+		{
+			tokens_->encodeSymbol(id, out);
+		}
+		else
+		{
+			tokens_->encodeSymbol(escape, out);
+			spelling_->encode(data + pos, length, out);
+			spelling_->encodeSymbol(TOKEN_END, out);
+		}
+		pos += length;
+	}
+}
+
+/**
+ * decode
+ * Preconditions: none
+ * Postconditions: size bytes are appended to out, returns false if
+ * the data ends early or the tokens do not add up to size bytes
+ * @param in: BitReader positioned at the first code
+ * @param size: number of bytes to decode
+ * @param out: vector the bytes are appended to
+ * @return: true if size bytes were decoded
+ */
+bool TokenCodebook::decode(BitReader &in, size_t size,
+									vector<uint8_t> &out) const
+{
+	int escape = vocabulary_.size();
+	size_t end = out.size() + size;
+	while (out.size() < end)
+	{
+		int id = tokens_->decodeSymbol(in);
+		if (id < 0)
+		{
+			return false;
+		}
+		if (id != escape)
+		{
+			const string &token = vocabulary_.getToken(id);
+			out.insert(out.end(), token.begin(), token.end());
+			continue;
+		}
+		for (size_t length = 0;; length++)
+		{
+			int c = spelling_->decodeSymbol(in);
+			if (c < 0 || length > MAX_TOKEN_LENGTH)
+			{
+				return false;
+			}
+			if (c == TOKEN_END)
+			{
+				break;
+			}
+			out.push_back((uint8_t)c);
+		}
+	}
+	return out.size() == end;
+}
+
+/**
+ * getWord
+ * this funtion takes in a string and then returns the
+ * code for that string, token by token
+ * Preconditions: none
+ * PostConditions: returns the code for the string entered
+ * @param in: string to encode
+ * @return: the code for the string entered
+ */
+string TokenCodebook::getWord(const string &in) const
+{
+	vector<uint8_t> packed;
+	BitWriter writer(packed);
+	encode((const uint8_t *)in.data(), in.size(), writer);
+	uint64_t count = writer.bitCount();
+	writer.flush();
+
+	string code(count, '0');
+	BitReader reader(packed.data(), packed.size());
+	for (uint64_t i = 0; i < count; i++)
+	{
+		code[i] = '0' + reader.readBit();
+	}
+	return code;
+}
+
+/**
+ * decode
+ * this function takes in a string of 0s and 1s produced by getWord
+ * and recovers the text
+ * Preconditions: none
+ * PostConditions: returns the text for the code entered, stopping
+ * at the last complete token
+ * @param bits: string of 0s and 1s
+ * @return: the decoded text
+ */
+string TokenCodebook::decode(const string &bits) const
+{
+	vector<uint8_t> packed;
+	BitWriter writer(packed);
+	for (char bit : bits)
+	{
+		writer.write(bit - '0', 1);
+	}
+	writer.flush();
+
+	// decode one token at a time, keeping it only if it ends in bits
+	string text = "";
+	BitReader reader(packed.data(), packed.size());
+	vector<uint8_t> token;
+	while (reader.position() < bits.length())
+	{
+		token.clear();
+		int id = tokens_->decodeSymbol(reader);
+		if (id < 0)
+		{
+			break;
+		}
+		if (id != vocabulary_.size())
+		{
+			const string &word = vocabulary_.getToken(id);
+			token.assign(word.begin(), word.end());
+		}
+		else
+		{
+			int c = spelling_->decodeSymbol(reader);
+			while (c >= 0 && c != TOKEN_END)
+			{
+				token.push_back((uint8_t)c);
+				c = spelling_->decodeSymbol(reader);
+			}
+			if (c < 0)
+			{
+				break;
+			}
+		}
+		if (reader.position() > bits.length())
+		{
+			break;
+		}
+		text.append(token.begin(), token.end());
+	}
+	return text;
+}
+
+/**
+ * serialize
+ * this function writes the separators, the vocabulary, the token
+ * code lengths and the spelling codebook header
+ * Preconditions: none
+ * Postconditions: the bytes are appended to out
+ * @param out: vector the bytes are appended to
+ */
+void TokenCodebook::serialize(vector<uint8_t> &out) const
+{
+	// one bit per byte value
+	for (int i = 0; i < 256; i += 8)
+	{
+		uint8_t flags = 0;
+		for (int k = 0; k < 8; k++)
+		{
+			flags |= separators_[i + k] << k;
+		}
+		out.push_back(flags);
+	}
+
+	writeVarint(vocabulary_.size(), out);
+	for (int id = 0; id < vocabulary_.size(); id++)
+	{
+		const string &token = vocabulary_.getToken(id);
+		writeVarint(token.size(), out);
+		out.insert(out.end(), token.begin(), token.end());
+	}
+	// token codes can be longer than a CodebookHeader allows, one byte
+	// per length
+	for (int id = 0; id <= vocabulary_.size(); id++)
+	{
+		out.push_back(tokens_->getLength(id));
+	}
+
+	int lengths[TOKEN_END + 1];
+	for (int i = 0; i <= TOKEN_END; i++)
+	{
+		lengths[i] = spelling_->getLength(i);
+	}
+	CodebookHeader::write(lengths, TOKEN_END + 1, out);
+}
+
+/**
+ * deserialize
+ * Preconditions: none
+ * Postconditions: returns the TokenCodebook, or nullptr if the bytes
+ * are malformed
+ * @param data: pointer to the serialized codebook
+ * @param size: number of bytes available
+ * @param used: set to the number of bytes read
+ * @return: the TokenCodebook or nullptr
+ */
+shared_ptr<const TokenCodebook> TokenCodebook::deserialize(const uint8_t *data,
+																			  size_t size,
+																			  size_t &used)
+{
+	shared_ptr<TokenCodebook> book(new TokenCodebook());
+	if (size < 32)
+	{
+		return nullptr;
+	}
+	book->separators_.resize(256);
+	for (int i = 0; i < 256; i++)
+	{
+		book->separators_[i] = (data[i / 8] >> (i % 8)) & 1;
+	}
+	size_t pos = 32;
+
+	uint64_t numTokens = 0;
+	size_t n = readVarint(data + pos, size - pos, numTokens);
+	// every token takes at least two bytes
+	if (n == 0 || numTokens > (size - pos) / 2)
+	{
+		return nullptr;
+	}
+	pos += n;
+	for (uint64_t id = 0; id < numTokens; id++)
+	{
+		uint64_t length = 0;
+		n = readVarint(data + pos, size - pos, length);
+		if (n == 0 || length == 0 || length > MAX_TOKEN_LENGTH ||
+			 length > size - pos - n)
+		{
+			return nullptr;
+		}
+		pos += n;
+		if (book->vocabulary_.intern(data + pos, length) != (int)id)
+		{
+			return nullptr;
+		}
+		pos += length;
+	}
+
+	// token lengths must fit and form a prefix code
+	if (numTokens + 1 > size - pos)
+	{
+		return nullptr;
+	}
+	vector<int> lengths(numTokens + 1);
+	const uint64_t one = (uint64_t)1 << MAX_TOKEN_CODE_LENGTH;
+	uint64_t kraft = 0;
+	for (uint64_t id = 0; id <= numTokens; id++)
+	{
+		lengths[id] = data[pos++];
+		if (lengths[id] > MAX_TOKEN_CODE_LENGTH)
+		{
+			return nullptr;
+		}
+		if (lengths[id] > 0)
+		{
+			kraft += one >> lengths[id];
+		}
+	}
+	if (kraft > one)
+	{
+		return nullptr;
+	}
+	book->tokens_ = CodeTable::fromLengths(lengths.data(), lengths.size(), 0);
+
+	int spellingLengths[TOKEN_END + 1];
+	int numSymbols = 0;
+	n = CodebookHeader::read(data + pos, size - pos, spellingLengths,
+									 TOKEN_END + 1, numSymbols);
+	if (n == 0 || numSymbols != TOKEN_END + 1)
+	{
+		return nullptr;
+	}
+	pos += n;
+	book->spelling_ = CodeTable::fromLengths(spellingLengths, TOKEN_END + 1, 0);
+	used = pos;
+	return book;
+}
+
+int TokenCodebook::getVocabularySize() const
+{
+	return vocabulary_.size();
+}
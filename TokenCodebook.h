@@ -0,0 +1,198 @@
+/*
+ * @file TokenCodebook.h
+ * @author Katarina McGaughy
+ * TokenCodebook class: The TokenCodebook class codes whole tokens
+ * instead of single letters. Text is split into tokens, each token is
+ * interned into a dense ID with a TokenTable, and the ID counts drive
+ * the codebook, so a common word costs a few bits in total instead of
+ * a few bits per letter. Separator bytes (spaces, punctuation, field
+ * delimiters) are tokens of their own, so no text is lost.
+ *
+ * Features:
+ * -word tokens (runs of letters and digits) or delimiter separated
+ *  fields
+ * -vocabulary of the most frequent tokens, built with
+ *  HuffmanAlgorithm::buildCodeLengthsSorted so it scales to millions of
+ *  tokens
+ * -tokens outside the vocabulary are sent as an escape code followed by
+ *  their bytes, spelled with a byte codebook and an end of token code
+ * -getWord and decode on strings of 0s and 1s, like CodeTable
+ * -serialize the vocabulary and both codebooks
+ *
+ * Assumptions:
+ * -tokens longer than MAX_TOKEN_LENGTH bytes are split
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BitStream.h"
+#include "CodeTable.h"
+#include "TokenTable.h"
+using namespace std;
+
+// longest code for a token, vocabularies can have millions of tokens
+const int MAX_TOKEN_CODE_LENGTH = 32;
+
+// longest token, longer runs are split into several tokens
+const size_t MAX_TOKEN_LENGTH = 64;
+
+// most tokens kept in the vocabulary
+const int DEFAULT_MAX_VOCABULARY = 1 << 20;
+
+// fewest times a token must be seen to join the vocabulary
+const int DEFAULT_MIN_TOKEN_COUNT = 2;
+
+class TokenCodebook
+{
+public:
+	/**
+	 * Overloaded constructor
+	 * this function splits sample into tokens, counts them, keeps the
+	 * maxVocabulary most frequent tokens seen at least minTokenCount
+	 * times and builds the token codebook and the spelling codebook
+	 * for escaped tokens
+	 * PreConditions: separators must have 256 entries
+	 * PostConditions: TokenCodebook is ready to encode and decode
+	 * @param sample: pointer to the training text
+	 * @param size: number of bytes
+	 * @param separators: true for each byte value that is a token of its
+	 * own and ends the token before it
+	 * @param maxVocabulary: most tokens kept
+	 * @param minTokenCount: fewest times a token must be seen to be kept
+	 */
+	TokenCodebook(const uint8_t *sample, size_t size,
+					  const vector<bool> &separators,
+					  int maxVocabulary = DEFAULT_MAX_VOCABULARY,
+					  int minTokenCount = DEFAULT_MIN_TOKEN_COUNT);
+
+	/**
+	 * wordSeparators
+	 * Preconditions: none
+	 * Postconditions: returns separators that make words of letters and
+	 * digits, every other byte is a token of its own
+	 * @return: separator flag of each byte value
+	 */
+	static vector<bool> wordSeparators();
+
+	/**
+	 * fieldSeparators
+	 * Preconditions: none
+	 * Postconditions: returns separators that make fields of everything
+	 * between delimiter and newline bytes
+	 * @param delimiter: byte between fields, such as ',' or '\t'
+	 * @return: separator flag of each byte value
+	 */
+	static vector<bool> fieldSeparators(char delimiter);
+
+	/**
+	 * encode
+	 * Preconditions: none
+	 * Postconditions: the codes for the tokens of data are written to out
+	 * @param data: pointer to the text
+	 * @param size: number of bytes
+	 * @param out: BitWriter the codes are written to
+	 */
+	void encode(const uint8_t *data, size_t size, BitWriter &out) const;
+
+	/**
+	 * decode
+	 * Preconditions: none
+	 * Postconditions: size bytes are appended to out, returns false if
+	 * the data ends early or the tokens do not add up to size bytes
+	 * @param in: BitReader positioned at the first code
+	 * @param size: number of bytes to decode
+	 * @param out: vector the bytes are appended to
+	 * @return: true if size bytes were decoded
+	 */
+	bool decode(BitReader &in, size_t size, vector<uint8_t> &out) const;
+
+	/**
+	 * getWord
+	 * this funtion takes in a string and then returns the
+	 * code for that string, token by token
+	 * Preconditions: none
+	 * PostConditions: returns the code for the string entered
+	 * @param in: string to encode
+	 * @return: the code for the string entered
+	 */
+	string getWord(const string &in) const;
+
+	/**
+	 * decode
+	 * this function takes in a string of 0s and 1s produced by getWord
+	 * and recovers the text
+	 * Preconditions: none
+	 * PostConditions: returns the text for the code entered, stopping
+	 * at the last complete token
+	 * @param bits: string of 0s and 1s
+	 * @return: the decoded text
+	 */
+	string decode(const string &bits) const;
+
+	/**
+	 * serialize
+	 * this function writes the separators, the vocabulary, the token
+	 * code lengths and the spelling codebook header
+	 * Preconditions: none
+	 * Postconditions: the bytes are appended to out
+	 * @param out: vector the bytes are appended to
+	 */
+	void serialize(vector<uint8_t> &out) const;
+
+	/**
+	 * deserialize
+	 * Preconditions: none
+	 * Postconditions: returns the TokenCodebook, or nullptr if the bytes
+	 * are malformed
+	 * @param data: pointer to the serialized codebook
+	 * @param size: number of bytes available
+	 * @param used: set to the number of bytes read
+	 * @return: the TokenCodebook or nullptr
+	 */
+	static shared_ptr<const TokenCodebook> deserialize(const uint8_t *data,
+																		size_t size, size_t &used);
+
+	/**
+	 * getVocabularySize
+	 * Preconditions: none
+	 * Postconditions: returns the number of tokens with their own code
+	 * @return: size of the vocabulary
+	 */
+	int getVocabularySize() const;
+
+private:
+	/**
+	 * default constructor, used by deserialize
+	 */
+	TokenCodebook() {}
+
+	/**
+	 * tokenLength
+	 * Preconditions: size must be at least 1
+	 * Postconditions: returns the length of the token at the start of
+	 * data
+	 */
+	size_t tokenLength(const uint8_t *data, size_t size) const;
+
+	// true for bytes that are tokens of their own
+	vector<bool> separators_;
+
+	// tokens with their own code, token ID is the symbol
+	TokenTable vocabulary_;
+
+	// codes for the vocabulary, symbol vocabulary_.size() is the escape
+	shared_ptr<const CodeTable> tokens_;
+
+	// codes for the bytes of escaped tokens, symbol 256 ends a token
+	shared_ptr<const CodeTable> spelling_;
+};
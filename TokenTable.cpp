@@ -0,0 +1,162 @@
+/*
+ * @file TokenTable.cpp
+ * @author Katarina McGaughy
+ * TokenTable class: The TokenTable class interns tokens (words, fields
+ * or any other byte strings) into dense IDs 0, 1, 2, ... in the order
+ * they are first seen, so token counts can be kept in an array and
+ * used as the symbols of a codebook.
+ *
+ * Features:
+ * -open addressing with linear probing in one flat array of slots
+ * -FNV-1a hashes kept per token, so probes compare hashes before bytes
+ *  and growing the table never hashes a token twice
+ * -at most half the slots in use
+ *
+ * Assumptions:
+ * -tokens are never removed
+ * -fewer than 2^31 distinct tokens
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "TokenTable.h"
+#include <cstring>
+
+// fewest slots a table starts with
+static const size_t MIN_SLOTS = 16;
+
+/**
+ * constructor
+ * Preconditions: none
+ * Postconditions: empty table with room for expected tokens before
+ * it has to grow
+ * @param expected: number of distinct tokens expected
+ */
+TokenTable::TokenTable(size_t expected)
+{
+	size_t slots = MIN_SLOTS;
+	while (slots < expected * 2)
+	{
+		slots *= 2;
+	}
+	slots_.assign(slots, -1);
+	tokens_.reserve(expected);
+	hashes_.reserve(expected);
+}
+
+/**
+ * intern
+ * Preconditions: none
+ * Postconditions: returns the ID of the token, adding it with the
+ * next free ID if it is new
+ * @param token: pointer to the bytes of the token
+ * @param length: number of bytes
+ * @return: ID of the token
+ */
+int TokenTable::intern(const uint8_t *token, size_t length)
+{
+	uint64_t h = hash(token, length);
+	size_t slot = slotOf(token, length, h);
+	if (slots_[slot] >= 0)
+	{
+		return slots_[slot];
+	}
+	int id = tokens_.size();
+	tokens_.push_back(string((const char *)token, length));
+	hashes_.push_back(h);
+	slots_[slot] = id;
+	if (tokens_.size() * 2 > slots_.size())
+	{
+		grow();
+	}
+	return id;
+}
+
+/**
+ * find
+ * Preconditions: none
+ * Postconditions: returns the ID of the token, or -1 if it was never
+ * interned
+ * @param token: pointer to the bytes of the token
+ * @param length: number of bytes
+ * @return: ID of the token or -1
+ */
+int TokenTable::find(const uint8_t *token, size_t length) const
+{
+	return slots_[slotOf(token, length, hash(token, length))];
+}
+
+int TokenTable::size() const
+{
+	return tokens_.size();
+}
+
+const string &TokenTable::getToken(int id) const
+{
+	return tokens_[id];
+}
+
+/**
+ * hash
+ * Preconditions: none
+ * Postconditions: returns the FNV-1a hash of the token
+ */
+uint64_t TokenTable::hash(const uint8_t *token, size_t length)
+{
+	uint64_t h = 14695981039346656037ULL;
+	for (size_t i = 0; i < length; i++)
+	{
+		h ^= token[i];
+		h *= 1099511628211ULL;
+	}
+	// fold the high bits in, the slot index only uses the low ones
+	return h ^ (h >> 32);
+}
+
+/**
+ * slotOf
+ * Preconditions: none
+ * Postconditions: returns the slot holding the token, or the empty
+ * slot where it would go
+ */
+size_t TokenTable::slotOf(const uint8_t *token, size_t length,
+								  uint64_t h) const
+{
+	size_t mask = slots_.size() - 1;
+	size_t slot = h & mask;
+	while (slots_[slot] >= 0)
+	{
+		int id = slots_[slot];
+		if (hashes_[id] == h && tokens_[id].size() == length &&
+			 memcmp(tokens_[id].data(), token, length) == 0)
+		{
+			break;
+		}
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+/**
+ * grow
+ * Preconditions: none
+ * Postconditions: the number of slots is doubled and every token is
+ * placed again
+ */
+void TokenTable::grow()
+{
+	slots_.assign(slots_.size() * 2, -1);
+	size_t mask = slots_.size() - 1;
+	for (size_t id = 0; id < tokens_.size(); id++)
+	{
+		size_t slot = hashes_[id] & mask;
+		while (slots_[slot] >= 0)
+		{
+			slot = (slot + 1) & mask;
+		}
+		slots_[slot] = id;
+	}
+}
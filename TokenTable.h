@@ -0,0 +1,106 @@
+/*
+ * @file TokenTable.h
+ * @author Katarina McGaughy
+ * TokenTable class: The TokenTable class interns tokens (words, fields
+ * or any other byte strings) into dense IDs 0, 1, 2, ... in the order
+ * they are first seen, so token counts can be kept in an array and
+ * used as the symbols of a codebook.
+ *
+ * Features:
+ * -open addressing with linear probing in one flat array of slots
+ * -FNV-1a hashes kept per token, so probes compare hashes before bytes
+ *  and growing the table never hashes a token twice
+ * -at most half the slots in use
+ *
+ * Assumptions:
+ * -tokens are never removed
+ * -fewer than 2^31 distinct tokens
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+class TokenTable
+{
+public:
+	/**
+	 * constructor
+	 * Preconditions: none
+	 * Postconditions: empty table with room for expected tokens before
+	 * it has to grow
+	 * @param expected: number of distinct tokens expected
+	 */
+	explicit TokenTable(size_t expected = 0);
+
+	/**
+	 * intern
+	 * Preconditions: none
+	 * Postconditions: returns the ID of the token, adding it with the
+	 * next free ID if it is new
+	 * @param token: pointer to the bytes of the token
+	 * @param length: number of bytes
+	 * @return: ID of the token
+	 */
+	int intern(const uint8_t *token, size_t length);
+
+	/**
+	 * find
+	 * Preconditions: none
+	 * Postconditions: returns the ID of the token, or -1 if it was never
+	 * interned
+	 * @param token: pointer to the bytes of the token
+	 * @param length: number of bytes
+	 * @return: ID of the token or -1
+	 */
+	int find(const uint8_t *token, size_t length) const;
+
+	/**
+	 * size, getToken
+	 * Preconditions: id must be between 0 and size() - 1
+	 * Postconditions: return the number of tokens, and the bytes of the
+	 * token with the given ID
+	 */
+	int size() const;
+	const string &getToken(int id) const;
+
+private:
+	/**
+	 * hash
+	 * Preconditions: none
+	 * Postconditions: returns the FNV-1a hash of the token
+	 */
+	static uint64_t hash(const uint8_t *token, size_t length);
+
+	/**
+	 * slotOf
+	 * Preconditions: none
+	 * Postconditions: returns the slot holding the token, or the empty
+	 * slot where it would go
+	 */
+	size_t slotOf(const uint8_t *token, size_t length, uint64_t h) const;
+
+	/**
+	 * grow
+	 * Preconditions: none
+	 * Postconditions: the number of slots is doubled and every token is
+	 * placed again
+	 */
+	void grow();
+
+	// bytes and hash of each token, indexed by ID
+	vector<string> tokens_;
+	vector<uint64_t> hashes_;
+
+	// ID stored in each slot, -1 for empty. The size is a power of 2
+	vector<int> slots_;
+};
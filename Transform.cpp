@@ -0,0 +1,194 @@
+/*
+ * @file Transform.cpp
+ * @author Katarina McGaughy
+ * Transform, MoveToFront and ZeroRunLength classes: A Transform rewrites
+ * a block of bytes before it is entropy coded, and undoes the rewrite
+ * after decoding. Huffman coding only sees how often each byte occurs,
+ * not how bytes repeat, so transforms that turn repetition into many
+ * small values (mostly 0) let the codebook take advantage of it.
+ *
+ * Features:
+ * -MoveToFront: each byte becomes its position in a list of recently
+ *  used bytes, so a byte repeated soon after becomes a small number and
+ *  a run of the same byte becomes a run of 0s
+ * -ZeroRunLength: each run of 0s becomes a 0 followed by the run length
+ *  minus one, runs longer than 256 take several pairs
+ * -every transform has an ID, so a block can name the transforms it used
+ *
+ * Assumptions:
+ * -transforms work on one block at a time and keep no state between
+ *  blocks, so blocks can still be decoded on their own
+ * -forward at most doubles the size of a block
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "Transform.h"
+#include <cstring>
+
+// longest run of 0s a single ZeroRunLength pair can hold
+static const size_t MAX_ZERO_RUN = 256;
+
+/**
+ * fromId
+ * Preconditions: none
+ * Postconditions: returns the transform with the given ID, or
+ * nullptr if there is none
+ * @param id: ID of the transform
+ * @return: the transform or nullptr
+ */
+shared_ptr<const Transform> Transform::fromId(uint8_t id)
+{
+	if (id == TRANSFORM_MOVE_TO_FRONT)
+	{
+		return make_shared<const MoveToFront>();
+	}
+	if (id == TRANSFORM_ZERO_RUN_LENGTH)
+	{
+		return make_shared<const ZeroRunLength>();
+	}
+	return nullptr;
+}
+
+TransformId MoveToFront::getId() const
+{
+	return TRANSFORM_MOVE_TO_FRONT;
+}
+
+/**
+ * forward
+ * this function replaces each byte with its position in the list of
+ * byte values and moves it to the front of the list
+ * Preconditions: none
+ * Postconditions: the positions are appended to out
+ */
+void MoveToFront::forward(const uint8_t *data, size_t size,
+								  vector<uint8_t> &out) const
+{
+	uint8_t list[256];
+	for (int i = 0; i < 256; i++)
+	{
+		list[i] = i;
+	}
+	for (size_t i = 0; i < size; i++)
+	{
+		uint8_t c = data[i];
+		int position = 0;
+		while (list[position] != c)
+		{
+			position++;
+		}
+		memmove(list + 1, list, position);
+		list[0] = c;
+		out.push_back(position);
+	}
+}
+
+/**
+ * inverse
+ * this function replaces each position with the byte at that position
+ * of the list and moves it to the front, the same way forward did
+ * Preconditions: none
+ * Postconditions: the bytes are appended to out, returns false if
+ * there are more than maxSize
+ */
+bool MoveToFront::inverse(const uint8_t *data, size_t size, size_t maxSize,
+								  vector<uint8_t> &out) const
+{
+	if (size > maxSize)
+	{
+		return false;
+	}
+	uint8_t list[256];
+	for (int i = 0; i < 256; i++)
+	{
+		list[i] = i;
+	}
+	for (size_t i = 0; i < size; i++)
+	{
+		int position = data[i];
+		uint8_t c = list[position];
+		memmove(list + 1, list, position);
+		list[0] = c;
+		out.push_back(c);
+	}
+	return true;
+}
+
+TransformId ZeroRunLength::getId() const
+{
+	return TRANSFORM_ZERO_RUN_LENGTH;
+}
+
+/**
+ * forward
+ * this function replaces each run of 0s with a 0 and the run length
+ * minus one, and copies every other byte
+ * Preconditions: none
+ * Postconditions: the transformed bytes are appended to out
+ */
+void ZeroRunLength::forward(const uint8_t *data, size_t size,
+									 vector<uint8_t> &out) const
+{
+	size_t i = 0;
+	while (i < size)
+	{
+		if (data[i] != 0)
+		{
+			out.push_back(data[i++]);
+			continue;
+		}
+		size_t run = 1;
+		while (i + run < size && data[i + run] == 0 && run < MAX_ZERO_RUN)
+		{
+			run++;
+		}
+		out.push_back(0);
+		out.push_back(run - 1);
+		i += run;
+	}
+}
+
+/**
+ * inverse
+ * this function expands each 0 and run length pair back into the run
+ * Preconditions: none
+ * Postconditions: the bytes are appended to out, returns false if a 0
+ * has no run length or there are more than maxSize bytes
+ */
+bool ZeroRunLength::inverse(const uint8_t *data, size_t size, size_t maxSize,
+									 vector<uint8_t> &out) const
+{
+	size_t produced = 0;
+	size_t i = 0;
+	while (i < size)
+	{
+		size_t run = 1;
+		if (data[i] == 0)
+		{
+			if (i + 1 == size)
+			{
+				return false;
+			}
+			run = data[i + 1] + 1;
+		}
+		produced += run;
+		if (produced > maxSize)
+		{
+			return false;
+		}
+		if (data[i] == 0)
+		{
+			out.insert(out.end(), run, 0);
+			i += 2;
+		}
+		else
+		{
+			out.push_back(data[i++]);
+		}
+	}
+	return true;
+}
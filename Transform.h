@@ -0,0 +1,115 @@
+/*
+ * @file Transform.h
+ * @author Katarina McGaughy
+ * Transform, MoveToFront and ZeroRunLength classes: A Transform rewrites
+ * a block of bytes before it is entropy coded, and undoes the rewrite
+ * after decoding. Huffman coding only sees how often each byte occurs,
+ * not how bytes repeat, so transforms that turn repetition into many
+ * small values (mostly 0) let the codebook take advantage of it.
+ *
+ * Features:
+ * -MoveToFront: each byte becomes its position in a list of recently
+ *  used bytes, so a byte repeated soon after becomes a small number and
+ *  a run of the same byte becomes a run of 0s
+ * -ZeroRunLength: each run of 0s becomes a 0 followed by the run length
+ *  minus one, runs longer than 256 take several pairs
+ * -every transform has an ID, so a block can name the transforms it used
+ *
+ * Assumptions:
+ * -transforms work on one block at a time and keep no state between
+ *  blocks, so blocks can still be decoded on their own
+ * -forward at most doubles the size of a block
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+using namespace std;
+
+// ID of each transform as stored in a block
+enum TransformId : uint8_t
+{
+	TRANSFORM_MOVE_TO_FRONT = 1,
+	TRANSFORM_ZERO_RUN_LENGTH = 2
+};
+
+class Transform
+{
+public:
+	/**
+	 * destructor
+	 */
+	virtual ~Transform() {}
+
+	/**
+	 * getId
+	 * Preconditions: none
+	 * Postconditions: returns the ID stored in blocks for this transform
+	 * @return: ID of the transform
+	 */
+	virtual TransformId getId() const = 0;
+
+	/**
+	 * forward
+	 * Preconditions: none
+	 * Postconditions: the transformed bytes are appended to out
+	 * @param data: pointer to the bytes
+	 * @param size: number of bytes
+	 * @param out: vector the transformed bytes are appended to
+	 */
+	virtual void forward(const uint8_t *data, size_t size,
+								vector<uint8_t> &out) const = 0;
+
+	/**
+	 * inverse
+	 * Preconditions: none
+	 * Postconditions: the original bytes are appended to out, returns
+	 * false if data could not have come from forward or would decode to
+	 * more than maxSize bytes
+	 * @param data: pointer to the transformed bytes
+	 * @param size: number of bytes
+	 * @param maxSize: most bytes the original can have
+	 * @param out: vector the original bytes are appended to
+	 * @return: true if data was undone
+	 */
+	virtual bool inverse(const uint8_t *data, size_t size, size_t maxSize,
+								vector<uint8_t> &out) const = 0;
+
+	/**
+	 * fromId
+	 * Preconditions: none
+	 * Postconditions: returns the transform with the given ID, or
+	 * nullptr if there is none
+	 * @param id: ID of the transform
+	 * @return: the transform or nullptr
+	 */
+	static shared_ptr<const Transform> fromId(uint8_t id);
+};
+
+class MoveToFront : public Transform
+{
+public:
+	TransformId getId() const override;
+	void forward(const uint8_t *data, size_t size,
+					 vector<uint8_t> &out) const override;
+	bool inverse(const uint8_t *data, size_t size, size_t maxSize,
+					 vector<uint8_t> &out) const override;
+};
+
+class ZeroRunLength : public Transform
+{
+public:
+	TransformId getId() const override;
+	void forward(const uint8_t *data, size_t size,
+					 vector<uint8_t> &out) const override;
+	bool inverse(const uint8_t *data, size_t size, size_t maxSize,
+					 vector<uint8_t> &out) const override;
+};
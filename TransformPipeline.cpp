@@ -0,0 +1,165 @@
+/*
+ * @file TransformPipeline.cpp
+ * @author Katarina McGaughy
+ * TransformPipeline class: The TransformPipeline class runs a list of
+ * Transforms in order in front of the entropy coder, and runs their
+ * inverses in reverse order after decoding. BlockCodec stores the
+ * pipeline in the block, so the decoder knows which inverses to apply.
+ *
+ * Features:
+ * -any number of transforms up to MAX_TRANSFORMS, in any order
+ * -the usual move-to-front then zero run length pipeline
+ * -serialize as a count and one ID byte per transform
+ *
+ * Assumptions:
+ * -transforms keep no state between blocks
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "TransformPipeline.h"
+
+/**
+ * moveToFrontRunLength
+ * Preconditions: none
+ * Postconditions: returns a pipeline of MoveToFront followed by
+ * ZeroRunLength
+ * @return: the pipeline
+ */
+TransformPipeline TransformPipeline::moveToFrontRunLength()
+{
+	TransformPipeline pipeline;
+	pipeline.add(make_shared<const MoveToFront>());
+	pipeline.add(make_shared<const ZeroRunLength>());
+	return pipeline;
+}
+
+/**
+ * add
+ * Preconditions: fewer than MAX_TRANSFORMS transforms are in the
+ * pipeline
+ * Postconditions: transform runs after the ones already added
+ * @param transform: transform to add
+ */
+void TransformPipeline::add(shared_ptr<const Transform> transform)
+{
+	transforms_.push_back(transform);
+}
+
+int TransformPipeline::size() const
+{
+	return transforms_.size();
+}
+
+/**
+ * forward
+ * this function runs each transform on the output of the one before
+ * Preconditions: none
+ * Postconditions: the transformed bytes are appended to out
+ * @param data: pointer to the bytes
+ * @param size: number of bytes
+ * @param out: vector the transformed bytes are appended to
+ */
+void TransformPipeline::forward(const uint8_t *data, size_t size,
+										  vector<uint8_t> &out) const
+{
+	vector<uint8_t> current(data, data + size);
+	vector<uint8_t> next;
+	for (size_t t = 0; t < transforms_.size(); t++)
+	{
+		next.clear();
+		transforms_[t]->forward(current.data(), current.size(), next);
+		current.swap(next);
+	}
+	out.insert(out.end(), current.begin(), current.end());
+}
+
+/**
+ * inverse
+ * this function runs the inverse of each transform, last first
+ * Preconditions: none
+ * Postconditions: the original bytes are appended to out, returns
+ * false if an inverse fails or the result is not exactly
+ * originalSize bytes
+ * @param data: pointer to the transformed bytes
+ * @param size: number of bytes
+ * @param originalSize: number of bytes before the transforms
+ * @param out: vector the original bytes are appended to
+ * @return: true if data was undone
+ */
+bool TransformPipeline::inverse(const uint8_t *data, size_t size,
+										  size_t originalSize,
+										  vector<uint8_t> &out) const
+{
+	vector<uint8_t> current(data, data + size);
+	vector<uint8_t> next;
+	for (size_t t = transforms_.size(); t-- > 0;)
+	{
+		// forward at most doubles the size, so the input of transform t
+		// was at most originalSize * 2^t
+		size_t maxSize = originalSize << t;
+		next.clear();
+		if (!transforms_[t]->inverse(current.data(), current.size(), maxSize,
+											  next))
+		{
+			return false;
+		}
+		current.swap(next);
+	}
+	if (current.size() != originalSize)
+	{
+		return false;
+	}
+	out.insert(out.end(), current.begin(), current.end());
+	return true;
+}
+
+/**
+ * serialize
+ * Preconditions: none
+ * Postconditions: the number of transforms and their IDs are
+ * appended to out
+ * @param out: vector the bytes are appended to
+ */
+void TransformPipeline::serialize(vector<uint8_t> &out) const
+{
+	out.push_back(transforms_.size());
+	for (size_t t = 0; t < transforms_.size(); t++)
+	{
+		out.push_back(transforms_[t]->getId());
+	}
+}
+
+/**
+ * deserialize
+ * Preconditions: none
+ * Postconditions: returns the number of bytes read, or 0 if the
+ * bytes are malformed or name an unknown transform
+ * @param data: pointer to the serialized pipeline
+ * @param size: number of bytes available
+ * @param pipeline: set to the pipeline read
+ * @return: number of bytes read, 0 on error
+ */
+size_t TransformPipeline::deserialize(const uint8_t *data, size_t size,
+												  TransformPipeline &pipeline)
+{
+	if (size == 0 || data[0] > MAX_TRANSFORMS || data[0] >= size)
+	{
+		return 0;
+	}
+	int count = data[0];
+	pipeline.transforms_.clear();
+	for (int t = 0; t < count; t++)
+	{
+		shared_ptr<const Transform> transform = Transform::fromId(data[1 + t]);
+		if (transform == nullptr)
+		{
+			return 0;
+		}
+		pipeline.add(transform);
+	}
+	return 1 + count;
+}
@@ -0,0 +1,115 @@
+/*
+ * @file TransformPipeline.h
+ * @author Katarina McGaughy
+ * TransformPipeline class: The TransformPipeline class runs a list of
+ * Transforms in order in front of the entropy coder, and runs their
+ * inverses in reverse order after decoding. BlockCodec stores the
+ * pipeline in the block, so the decoder knows which inverses to apply.
+ *
+ * Features:
+ * -any number of transforms up to MAX_TRANSFORMS, in any order
+ * -the usual move-to-front then zero run length pipeline
+ * -serialize as a count and one ID byte per transform
+ *
+ * Assumptions:
+ * -transforms keep no state between blocks
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Transform.h"
+using namespace std;
+
+// most transforms in one pipeline
+const int MAX_TRANSFORMS = 8;
+
+class TransformPipeline
+{
+public:
+	/**
+	 * moveToFrontRunLength
+	 * Preconditions: none
+	 * Postconditions: returns a pipeline of MoveToFront followed by
+	 * ZeroRunLength
+	 * @return: the pipeline
+	 */
+	static TransformPipeline moveToFrontRunLength();
+
+	/**
+	 * add
+	 * Preconditions: fewer than MAX_TRANSFORMS transforms are in the
+	 * pipeline
+	 * Postconditions: transform runs after the ones already added
+	 * @param transform: transform to add
+	 */
+	void add(shared_ptr<const Transform> transform);
+
+	/**
+	 * size
+	 * Preconditions: none
+	 * Postconditions: returns the number of transforms
+	 * @return: number of transforms
+	 */
+	int size() const;
+
+	/**
+	 * forward
+	 * this function runs each transform on the output of the one before
+	 * Preconditions: none
+	 * Postconditions: the transformed bytes are appended to out
+	 * @param data: pointer to the bytes
+	 * @param size: number of bytes
+	 * @param out: vector the transformed bytes are appended to
+	 */
+	void forward(const uint8_t *data, size_t size, vector<uint8_t> &out) const;
+
+	/**
+	 * inverse
+	 * this function runs the inverse of each transform, last first
+	 * Preconditions: none
+	 * Postconditions: the original bytes are appended to out, returns
+	 * false if an inverse fails or the result is not exactly
+	 * originalSize bytes
+	 * @param data: pointer to the transformed bytes
+	 * @param size: number of bytes
+	 * @param originalSize: number of bytes before the transforms
+	 * @param out: vector the original bytes are appended to
+	 * @return: true if data was undone
+	 */
+	bool inverse(const uint8_t *data, size_t size, size_t originalSize,
+					 vector<uint8_t> &out) const;
+
+	/**
+	 * serialize
+	 * Preconditions: none
+	 * Postconditions: the number of transforms and their IDs are
+	 * appended to out
+	 * @param out: vector the bytes are appended to
+	 */
+	void serialize(vector<uint8_t> &out) const;
+
+	/**
+	 * deserialize
+	 * Preconditions: none
+	 * Postconditions: returns the number of bytes read, or 0 if the
+	 * bytes are malformed or name an unknown transform
+	 * @param data: pointer to the serialized pipeline
+	 * @param size: number of bytes available
+	 * @param pipeline: set to the pipeline read
+	 * @return: number of bytes read, 0 on error
+	 */
+	static size_t deserialize(const uint8_t *data, size_t size,
+									  TransformPipeline &pipeline);
+
+private:
+	vector<shared_ptr<const Transform>> transforms_;
+};
@@ -0,0 +1,84 @@
+/*
+ * @file Varint.h
+ * @author Katarina McGaughy
+ * writeVarint and readVarint functions: store unsigned integers in 7 bit
+ * groups, low bits first, with the high bit of each byte set when more
+ * bytes follow. Small numbers such as symbol counts and dictionary IDs
+ * take a single byte.
+ *
+ * Assumptions:
+ * -values fit in 64 bits
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+/**
+ * writeVarint
+ * Preconditions: none
+ * Postconditions: value is appended to out
+ * @param value: number to write
+ * @param out: vector the bytes are appended to
+ */
+inline void writeVarint(uint64_t value, vector<uint8_t> &out)
+{
+	while (value >= 0x80)
+	{
+		out.push_back((uint8_t)((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	out.push_back((uint8_t)value);
+}
+
+/**
+ * varintSize
+ * Preconditions: none
+ * Postconditions: returns the number of bytes writeVarint uses for value
+ * @param value: number to measure
+ * @return: number of bytes
+ */
+inline size_t varintSize(uint64_t value)
+{
+	size_t bytes = 1;
+	while (value >= 0x80)
+	{
+		value >>= 7;
+		bytes++;
+	}
+	return bytes;
+}
+
+/**
+ * readVarint
+ * Preconditions: none
+ * Postconditions: returns the number of bytes read, or 0 if the data
+ * ends first or the value does not fit in 64 bits
+ * @param data: pointer to the first byte
+ * @param size: number of bytes available
+ * @param value: set to the number read
+ * @return: number of bytes read, 0 on error
+ */
+inline size_t readVarint(const uint8_t *data, size_t size, uint64_t &value)
+{
+	value = 0;
+	int shift = 0;
+	for (size_t pos = 0; pos < size && shift < 64; pos++)
+	{
+		value |= (uint64_t)(data[pos] & 0x7F) << shift;
+		shift += 7;
+		if ((data[pos] & 0x80) == 0)
+		{
+			return pos + 1;
+		}
+	}
+	return 0;
+}